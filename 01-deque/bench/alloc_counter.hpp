@@ -0,0 +1,94 @@
+#ifndef _ALLOC_COUNTER_H
+#define _ALLOC_COUNTER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+/* Replaces the global operator new/delete to count heap allocations.
+ * Include this from exactly one translation unit of a benchmark. */
+namespace alloc_counter {
+inline std::atomic<size_t> allocations{0};
+inline std::atomic<size_t> live_bytes{0};
+inline std::atomic<size_t> peak_bytes{0};
+
+inline void reset() {
+    allocations = 0;
+    peak_bytes = live_bytes.load();
+}
+
+/* Each block is prefixed with its size, so that delete can account for it. */
+constexpr size_t header = alignof(std::max_align_t);
+
+inline void* allocate(size_t n) {
+    void* p = std::malloc(n + header);
+    if (!p)
+        throw std::bad_alloc{};
+
+    *static_cast<size_t*>(p) = n;
+    allocations++;
+    size_t now = live_bytes += n;
+    size_t peak = peak_bytes.load();
+    while (now > peak && !peak_bytes.compare_exchange_weak(peak, now))
+        ;
+    return static_cast<char*>(p) + header;
+}
+
+inline void deallocate(void* p) {
+    if (!p)
+        return;
+
+    void* base = static_cast<char*>(p) - header;
+    live_bytes -= *static_cast<size_t*>(base);
+    std::free(base);
+}
+
+/* Over-aligned blocks (e.g. ArrayDeque's raw storage) get a prefix of a
+   whole alignment, with the size in its last word. */
+inline size_t aligned_header(std::align_val_t align) {
+    return std::max(header, static_cast<size_t>(align));
+}
+
+inline void* allocate(size_t n, std::align_val_t align) {
+    size_t prefix = aligned_header(align);
+    size_t total = (n + prefix + prefix - 1) / prefix * prefix;
+    char* base = static_cast<char*>(std::aligned_alloc(prefix, total));
+    if (!base)
+        throw std::bad_alloc{};
+
+    char* p = base + prefix;
+    reinterpret_cast<size_t*>(p)[-1] = n;
+    allocations++;
+    size_t now = live_bytes += n;
+    size_t peak = peak_bytes.load();
+    while (now > peak && !peak_bytes.compare_exchange_weak(peak, now))
+        ;
+    return p;
+}
+
+inline void deallocate(void* p, std::align_val_t align) {
+    if (!p)
+        return;
+
+    live_bytes -= static_cast<size_t*>(p)[-1];
+    std::free(static_cast<char*>(p) - aligned_header(align));
+}
+} // namespace alloc_counter
+
+void* operator new(size_t n) { return alloc_counter::allocate(n); }
+void* operator new[](size_t n) { return alloc_counter::allocate(n); }
+void operator delete(void* p) noexcept { alloc_counter::deallocate(p); }
+void operator delete[](void* p) noexcept { alloc_counter::deallocate(p); }
+void operator delete(void* p, size_t) noexcept { alloc_counter::deallocate(p); }
+void operator delete[](void* p, size_t) noexcept { alloc_counter::deallocate(p); }
+
+void* operator new(size_t n, std::align_val_t a) { return alloc_counter::allocate(n, a); }
+void* operator new[](size_t n, std::align_val_t a) { return alloc_counter::allocate(n, a); }
+void operator delete(void* p, std::align_val_t a) noexcept { alloc_counter::deallocate(p, a); }
+void operator delete[](void* p, std::align_val_t a) noexcept { alloc_counter::deallocate(p, a); }
+void operator delete(void* p, size_t, std::align_val_t a) noexcept { alloc_counter::deallocate(p, a); }
+void operator delete[](void* p, size_t, std::align_val_t a) noexcept { alloc_counter::deallocate(p, a); }
+
+#endif // _ALLOC_COUNTER_H
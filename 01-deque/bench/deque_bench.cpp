@@ -0,0 +1,223 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "deque.hpp"
+#include "block_deque.hpp"
+#include "unrolled_deque.hpp"
+#include "alloc_counter.hpp"
+#include "perf_counter.hpp"
+
+/* Compares the deque backends against std::deque on the same workloads:
+ *
+ *   fifo      push_back N items, then remove_front them all
+ *   lifo      push_front N items, then remove_front them all
+ *   both      push N items alternately at either end, then remove
+ *             alternately from either end
+ *   index     read random positions of a deque of N items with operator[]:
+ *             N of them, or N / 1000 for the linked backends, where each
+ *             read walks the list. Filling the deque is not timed.
+ *   mixed     2N random operations, 55% pushes and 45% removes, at random
+ *             ends, so the deque hovers around a slowly growing size
+ *
+ * with items of 8, 64 and 256 bytes. For each run it prints millions of
+ * operations per second, cache misses per operation (when perf counters are
+ * available), and the peak heap use in MiB.
+ * Usage: deque_bench [N] */
+
+template <size_t Bytes>
+struct Item {
+    uint64_t key;
+    std::array<char, Bytes - sizeof(uint64_t)> payload;
+
+    Item() = default;
+    explicit Item(uint64_t key) : key(key) {}
+};
+
+/* std::deque with the DequeLike interface */
+template <typename T>
+class StdDeque {
+public:
+    using value_type = T;
+
+    void push_front(const T& t) { deque.push_front(t); }
+    void push_back(const T& t) { deque.push_back(t); }
+
+    std::optional<T> remove_front() {
+        if (deque.empty())
+            return std::nullopt;
+        std::optional<T> t = std::move(deque.front());
+        deque.pop_front();
+        return t;
+    }
+
+    std::optional<T> remove_back() {
+        if (deque.empty())
+            return std::nullopt;
+        std::optional<T> t = std::move(deque.back());
+        deque.pop_back();
+        return t;
+    }
+
+    bool empty() { return deque.empty(); }
+    size_t size() { return deque.size(); }
+    T& operator[](size_t i) { return deque[i]; }
+
+private:
+    std::deque<T> deque;
+};
+
+/* Keeps results alive so the compiler cannot drop the work */
+volatile uint64_t sink;
+
+template <typename D>
+size_t fifo(D& d, size_t n) {
+    for (size_t i = 0; i < n; i++)
+        d.push_back(typename D::value_type(i));
+    uint64_t sum = 0;
+    while (auto t = d.remove_front())
+        sum += t->key;
+    sink = sum;
+    return 2 * n;
+}
+
+template <typename D>
+size_t lifo(D& d, size_t n) {
+    for (size_t i = 0; i < n; i++)
+        d.push_front(typename D::value_type(i));
+    uint64_t sum = 0;
+    while (auto t = d.remove_front())
+        sum += t->key;
+    sink = sum;
+    return 2 * n;
+}
+
+template <typename D>
+size_t both(D& d, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (i % 2)
+            d.push_front(typename D::value_type(i));
+        else
+            d.push_back(typename D::value_type(i));
+    }
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; i++)
+        sum += (i % 2 ? d.remove_front() : d.remove_back())->key;
+    sink = sum;
+    return 2 * n;
+}
+
+/* Setup for index */
+template <typename D>
+void fill(D& d, size_t n) {
+    for (size_t i = 0; i < n; i++)
+        d.push_back(typename D::value_type(i));
+}
+
+template <typename D, size_t ReadsPerThousand>
+size_t index(D& d, size_t n) {
+    size_t reads = std::max<size_t>(1, n * ReadsPerThousand / 1000);
+    std::mt19937_64 gen(15);
+    uint64_t sum = 0;
+    for (size_t i = 0; i < reads; i++)
+        sum += d[gen() % n].key;
+    sink = sum;
+    return reads;
+}
+
+template <typename D>
+size_t mixed(D& d, size_t n) {
+    std::mt19937_64 gen(15);
+    uint64_t sum = 0;
+    for (size_t i = 0; i < 2 * n; i++) {
+        uint64_t r = gen() % 100;
+        if (r < 55) {
+            if (r % 2)
+                d.push_front(typename D::value_type(i));
+            else
+                d.push_back(typename D::value_type(i));
+        } else {
+            auto t = r % 2 ? d.remove_front() : d.remove_back();
+            if (t)
+                sum += t->key;
+        }
+    }
+    sink = sum;
+    return 2 * n;
+}
+
+/* Runs `run` on a new deque, after `setup` if there is one. Only `run` is
+   timed and counted, but the peak heap use includes what `setup` built. */
+template <typename D, typename Workload>
+void measure(const char* workload, const char* backend, size_t bytes, Workload run, size_t n,
+             void (*setup)(D&, size_t) = nullptr) {
+    CacheMissCounter misses;
+
+    alloc_counter::reset();
+    D d;
+    if (setup)
+        setup(d, n);
+
+    misses.start();
+    auto start = std::chrono::steady_clock::now();
+    size_t ops = run(d, n);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::optional<uint64_t> missed = misses.stop();
+
+    std::cout << std::left << std::setw(8) << workload << std::setw(12) << backend << std::right
+              << std::setw(6) << bytes << std::fixed << std::setprecision(2) << std::setw(12)
+              << ops / elapsed.count() / 1e6;
+    if (missed)
+        std::cout << std::setw(14) << static_cast<double>(*missed) / ops;
+    else
+        std::cout << std::setw(14) << "-";
+    std::cout << std::setw(12) << alloc_counter::peak_bytes / (1024.0 * 1024.0) << '\n';
+}
+
+template <size_t Bytes, template <typename> typename D, bool Linked = false>
+void workloads(const char* backend, size_t n) {
+    using Deq = D<Item<Bytes>>;
+    measure<Deq>("fifo", backend, Bytes, fifo<Deq>, n);
+    measure<Deq>("lifo", backend, Bytes, lifo<Deq>, n);
+    measure<Deq>("both", backend, Bytes, both<Deq>, n);
+    measure<Deq>("index", backend, Bytes, index<Deq, Linked ? 1 : 1000>, n, fill<Deq>);
+    measure<Deq>("mixed", backend, Bytes, mixed<Deq>, n);
+}
+
+template <typename T>
+using DefaultListDeque = ListDeque<T>;
+template <typename T>
+using DefaultBlockDeque = BlockDeque<T>;
+template <typename T>
+using DefaultUnrolledListDeque = UnrolledListDeque<T>;
+
+template <size_t Bytes>
+void backends(size_t n) {
+    workloads<Bytes, StdDeque>("std::deque", n);
+    workloads<Bytes, ArrayDeque>("ArrayDeque", n);
+    workloads<Bytes, DefaultListDeque, true>("ListDeque", n);
+    workloads<Bytes, DefaultBlockDeque>("BlockDeque", n);
+    workloads<Bytes, DefaultUnrolledListDeque, true>("Unrolled", n);
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = argc > 1 ? std::stoul(argv[1]) : 1000000;
+
+    if (!CacheMissCounter().available())
+        std::cout << "(perf counters unavailable: no cache miss counts)\n";
+
+    std::cout << std::left << std::setw(8) << "work" << std::setw(12) << "deque" << std::right
+              << std::setw(6) << "bytes" << std::setw(12) << "Mops/s" << std::setw(14)
+              << "misses/op" << std::setw(12) << "peak MiB" << '\n';
+
+    backends<8>(n);
+    backends<64>(n);
+    backends<256>(n / 4);
+}
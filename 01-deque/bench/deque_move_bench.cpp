@@ -0,0 +1,87 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+#include "deque.hpp"
+#include "block_deque.hpp"
+
+#include "alloc_counter.hpp"
+
+/* Round-trips payloads through a deque (push_back then remove_front) and
+ * reports the number of heap allocations per round trip. The deque is warmed
+ * up first so that growing its storage is not counted. */
+
+constexpr size_t N = 100'000;
+constexpr size_t WINDOW = 1000;
+
+enum class Push { COPY, MOVE, EMPLACE };
+
+template <typename Deque, typename T, typename Make>
+double allocs_per_op(Push mode, Make make) {
+    Deque deque;
+    std::vector<T> payloads;
+    for (size_t i = 0; i < WINDOW; i++)
+        payloads.push_back(make(i));
+
+    /* Warm up: fill the window once and drain it. */
+    for (auto& p : payloads)
+        deque.push_back(p);
+    for (size_t i = 0; i < WINDOW; i++)
+        deque.remove_front();
+
+    alloc_counter::reset();
+    for (size_t i = 0; i < N; i++) {
+        T& p = payloads[i % WINDOW];
+        switch (mode) {
+        case Push::COPY:
+            deque.push_back(p);
+            p = deque.remove_front().value();
+            break;
+        case Push::MOVE:
+            deque.push_back(std::move(p));
+            p = std::move(deque.remove_front().value());
+            break;
+        case Push::EMPLACE:
+            deque.emplace_back(std::move(p));
+            p = *deque.remove_front();
+            break;
+        }
+    }
+
+    return static_cast<double>(alloc_counter::allocations) / N;
+}
+
+template <typename T, typename Make>
+void report(const char* payload, Make make) {
+    const std::pair<Push, const char*> modes[] = {
+        { Push::COPY, "push(const T&)" },
+        { Push::MOVE, "push(T&&)" },
+        { Push::EMPLACE, "emplace" },
+    };
+
+    for (auto [mode, name] : modes) {
+        std::cout << std::left << std::setw(18) << payload
+                  << std::setw(16) << name << std::fixed << std::setprecision(3)
+                  << std::setw(12) << allocs_per_op<ArrayDeque<T>, T>(mode, make)
+                  << std::setw(12) << allocs_per_op<ListDeque<T>, T>(mode, make)
+                  << std::setw(12) << allocs_per_op<BlockDeque<T>, T>(mode, make)
+                  << '\n';
+    }
+}
+
+int main() {
+    std::cout << "heap allocations per push/remove round trip\n";
+    std::cout << std::left << std::setw(18) << "payload" << std::setw(16) << "push"
+              << std::setw(12) << "Array" << std::setw(12) << "List"
+              << std::setw(12) << "Block" << '\n';
+
+    report<std::string>("std::string(64)", [](size_t i) {
+        return std::string(64, 'a' + i % 26);
+    });
+    report<std::vector<int>>("std::vector(16)", [](size_t i) {
+        return std::vector<int>(16, i);
+    });
+
+    return 0;
+}
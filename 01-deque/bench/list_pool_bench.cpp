@@ -0,0 +1,94 @@
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+#include "deque.hpp"
+
+#include "alloc_counter.hpp"
+
+/* Push/remove throughput of ListDeque with pooled nodes (the default) against
+ * one heap allocation per node. Usage: list_pool_bench [ops] */
+
+using HeapListDeque = ListDeque<int, HeapNodeAllocator<ListNode<int>>>;
+using PooledListDeque = ListDeque<int>;
+
+struct Result {
+    double mops;
+    double allocs_per_op;
+};
+
+template <typename Deque, typename Workload>
+Result run(size_t ops, Workload workload) {
+    Deque deque;
+    alloc_counter::reset();
+
+    auto start = std::chrono::steady_clock::now();
+    workload(deque, ops);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    return { ops / elapsed.count() / 1e6,
+             static_cast<double>(alloc_counter::allocations) / ops };
+}
+
+/* A queue that stays around 1000 items */
+template <typename Deque>
+void fifo(Deque& deque, size_t ops) {
+    for (int i = 0; i < 1000; i++)
+        deque.push_back(i);
+    for (size_t i = 0; i < ops / 2; i++) {
+        deque.push_back(i);
+        deque.remove_front();
+    }
+}
+
+/* A stack that repeatedly grows to 10000 items and shrinks back */
+template <typename Deque>
+void lifo(Deque& deque, size_t ops) {
+    for (size_t i = 0; i < ops / 20000; i++) {
+        for (int j = 0; j < 10000; j++)
+            deque.push_front(j);
+        for (int j = 0; j < 10000; j++)
+            deque.remove_front();
+    }
+}
+
+/* Both ends, in a fixed pseudo-random order */
+template <typename Deque>
+void mixed(Deque& deque, size_t ops) {
+    unsigned x = 12345;
+    for (size_t i = 0; i < ops; i++) {
+        x = x * 1103515245 + 12345;
+        switch ((x >> 16) % 4) {
+        case 0: deque.push_front(i); break;
+        case 1: deque.push_back(i); break;
+        case 2: deque.remove_front(); break;
+        default: deque.remove_back();
+        }
+    }
+}
+
+template <typename Workload>
+void report(const std::string& name, size_t ops, Workload workload) {
+    Result heap = run<HeapListDeque>(ops, workload);
+    Result pooled = run<PooledListDeque>(ops, workload);
+
+    std::cout << std::left << std::setw(10) << name << std::fixed << std::setprecision(2)
+              << std::setw(12) << heap.mops << std::setw(12) << heap.allocs_per_op
+              << std::setw(12) << pooled.mops << std::setw(12) << pooled.allocs_per_op
+              << '\n';
+}
+
+int main(int argc, char* argv[]) {
+    size_t ops = argc > 1 ? std::stoul(argv[1]) : 10'000'000;
+
+    std::cout << std::left << std::setw(10) << "workload"
+              << std::setw(12) << "heap Mop/s" << std::setw(12) << "allocs/op"
+              << std::setw(12) << "pool Mop/s" << std::setw(12) << "allocs/op" << '\n';
+
+    report("fifo", ops, [](auto& d, size_t n) { fifo(d, n); });
+    report("lifo", ops, [](auto& d, size_t n) { lifo(d, n); });
+    report("mixed", ops, [](auto& d, size_t n) { mixed(d, n); });
+
+    return 0;
+}
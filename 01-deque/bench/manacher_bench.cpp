@@ -0,0 +1,42 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "manacher.hpp"
+
+/* Throughput of manacher_batch() over a batch of random documents, for 1, 2,
+ * 4, ... threads up to the hardware thread count. The alphabet is small so
+ * that the documents are full of palindromes.
+ * Usage: manacher_bench [documents] [document length] */
+
+int main(int argc, char* argv[]) {
+    size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2000;
+    size_t length = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 50000;
+
+    std::mt19937 gen(42);
+    std::vector<std::string> texts(count);
+    for (auto& t : texts) {
+        t.resize(length);
+        for (auto& c : t)
+            c = "abc"[gen() % 3];
+    }
+    std::vector<std::string_view> docs(texts.begin(), texts.end());
+    double mbytes = static_cast<double>(count) * length / 1e6;
+
+    std::cout << count << " documents of " << length << " bytes\n";
+    unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+        auto start = std::chrono::steady_clock::now();
+        ManacherBatchResult r = manacher_batch(docs, 2, threads);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        std::cout << std::setw(3) << threads << " threads: " << std::fixed << std::setprecision(1)
+                  << std::setw(8) << mbytes / elapsed.count() << " MB/s, "
+                  << r.maximal_start.size() << " maximal palindromes\n";
+    }
+}
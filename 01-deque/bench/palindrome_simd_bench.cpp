@@ -0,0 +1,90 @@
+#include <cctype>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+#include "palindrome_simd.hpp"
+
+/* is_palindrome_simd() on a mirrored text of English prose, with each set
+ * of options, against a scalar loop that filters and folds byte by byte.
+ *
+ * Nearly every block of prose holds a space or a punctuation mark, so the
+ * skip_non_alnum rows measure the packing of the kept bytes rather than the
+ * straight block compare of the first rows.
+ * Usage: palindrome_simd_bench [length] [rounds] */
+
+static const char prose[] =
+    "It was the best of times, it was the worst of times, it was the age of "
+    "wisdom, it was the age of foolishness, it was the epoch of belief, it was "
+    "the epoch of incredulity, it was the season of Light, it was the season "
+    "of Darkness, it was the spring of hope, it was the winter of despair. ";
+
+static bool scalar_palindrome(const std::string& s, const PalindromeOptions& opts) {
+    size_t i = 0, j = s.size();
+    auto kept = [&](char c) {
+        return !opts.skip_non_alnum || std::isalnum(static_cast<unsigned char>(c));
+    };
+    auto fold = [&](char c) {
+        return opts.fold_case ? std::tolower(static_cast<unsigned char>(c)) : c;
+    };
+
+    while (true) {
+        while (i < j && !kept(s[i]))
+            i++;
+        while (i < j && !kept(s[j - 1]))
+            j--;
+        if (j - i < 2)
+            return true;
+        if (fold(s[i]) != fold(s[j - 1]))
+            return false;
+        i++;
+        j--;
+    }
+}
+
+template <typename F>
+double mbytes_per_sec(F check, const std::string& s, size_t rounds) {
+    size_t found = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < rounds; i++)
+        found += check(s);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    if (found != rounds)
+        std::cerr << "unexpected result\n";
+    return s.size() * rounds / elapsed.count() / 1e6;
+}
+
+void report(const char* name, const std::string& s, const PalindromeOptions& opts, size_t rounds) {
+    double scalar = mbytes_per_sec([&](const std::string& t) { return scalar_palindrome(t, opts); },
+                                   s, rounds);
+    double simd = mbytes_per_sec([&](const std::string& t) { return is_palindrome_simd(t, opts); },
+                                 s, rounds);
+
+    std::cout << std::left << std::setw(20) << name << std::fixed << std::setprecision(1)
+              << std::setw(12) << scalar << std::setw(12) << simd
+              << std::setprecision(2) << simd / scalar << "x\n";
+}
+
+int main(int argc, char* argv[]) {
+    size_t length = argc > 1 ? std::stoul(argv[1]) : 1'000'000;
+    size_t rounds = argc > 2 ? std::stoul(argv[2]) : 50;
+
+    std::string half;
+    while (half.size() < length / 2)
+        half += prose;
+    half.resize(length / 2);
+    std::string s = half + std::string(half.rbegin(), half.rend());
+
+    std::cout << "MB/s, block of " << palindrome_detail::block_size << " bytes\n"
+              << std::left << std::setw(20) << "options"
+              << std::setw(12) << "scalar" << std::setw(12) << "simd" << "speedup\n";
+
+    report("exact", s, {false, false}, rounds);
+    report("fold_case", s, {true, false}, rounds);
+    report("skip_non_alnum", s, {false, true}, rounds);
+    report("fold + skip", s, {true, true}, rounds);
+
+    return 0;
+}
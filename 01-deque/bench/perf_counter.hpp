@@ -0,0 +1,72 @@
+#ifndef _PERF_COUNTER_H
+#define _PERF_COUNTER_H
+
+#include <cstdint>
+#include <cstring>
+#include <optional>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/* Counts hardware cache misses of this thread with perf_event_open(2).
+ * When the counter is not available (not Linux, no PMU in a VM, or
+ * perf_event_paranoid forbids it), available() is false and read() returns
+ * std::nullopt, so benchmarks can print "-" instead. */
+class CacheMissCounter {
+public:
+    CacheMissCounter() {
+#if defined(__linux__)
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+
+    ~CacheMissCounter() {
+#if defined(__linux__)
+        if (fd >= 0)
+            close(fd);
+#endif
+    }
+
+    CacheMissCounter(const CacheMissCounter&) = delete;
+    CacheMissCounter& operator=(const CacheMissCounter&) = delete;
+
+    bool available() const { return fd >= 0; }
+
+    void start() {
+#if defined(__linux__)
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    std::optional<uint64_t> stop() {
+#if defined(__linux__)
+        uint64_t count;
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            if (::read(fd, &count, sizeof(count)) == sizeof(count))
+                return count;
+        }
+#endif
+        return std::nullopt;
+    }
+
+private:
+    int fd = -1;
+};
+
+#endif // _PERF_COUNTER_H
@@ -0,0 +1,104 @@
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "deque.hpp"
+#include "ring_deque.hpp"
+
+/* Throughput of the concurrent rings against an ArrayDeque behind a mutex.
+ * With `t` threads, half of them produce and half consume (a single thread
+ * alternates between pushing and removing). Usage: ring_bench [max-threads] */
+
+constexpr size_t ITEMS = 2'000'000;
+
+class LockedArrayDeque {
+public:
+    explicit LockedArrayDeque(size_t) {}
+
+    bool push_back(size_t item) {
+        std::lock_guard<std::mutex> lock(m);
+        deque.push_back(item);
+        return true;
+    }
+
+    std::optional<size_t> remove_front() {
+        std::lock_guard<std::mutex> lock(m);
+        return deque.remove_front();
+    }
+
+private:
+    std::mutex m;
+    ArrayDeque<size_t> deque;
+};
+
+/* Returns millions of items per second */
+template <typename Ring>
+double run(size_t threads) {
+    Ring ring(4096);
+    size_t producers = std::max<size_t>(1, threads / 2);
+    size_t consumers = std::max<size_t>(1, threads - producers);
+    size_t per_producer = ITEMS / producers;
+    size_t total = per_producer * producers;
+
+    auto start = std::chrono::steady_clock::now();
+
+    if (threads == 1) {
+        for (size_t i = 0; i < total; i++) {
+            ring.push_back(i);
+            ring.remove_front();
+        }
+    } else {
+        std::atomic<size_t> consumed{0};
+        std::vector<std::thread> ts;
+
+        for (size_t p = 0; p < producers; p++) {
+            ts.emplace_back([&] {
+                for (size_t i = 0; i < per_producer; i++)
+                    while (!ring.push_back(i))
+                        std::this_thread::yield();
+            });
+        }
+        for (size_t c = 0; c < consumers; c++) {
+            ts.emplace_back([&] {
+                while (consumed.load(std::memory_order_relaxed) < total) {
+                    if (ring.remove_front())
+                        consumed.fetch_add(1, std::memory_order_relaxed);
+                    else
+                        std::this_thread::yield();
+                }
+            });
+        }
+        for (auto& t : ts)
+            t.join();
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return total / elapsed.count() / 1e6;
+}
+
+int main(int argc, char* argv[]) {
+    size_t max_threads = argc > 1 ? std::stoul(argv[1])
+                                  : std::max(2u, std::thread::hardware_concurrency());
+
+    std::cout << "Mitems/s\n";
+    std::cout << std::left << std::setw(10) << "threads" << std::setw(12) << "SPSC"
+              << std::setw(12) << "MPMC" << std::setw(12) << "mutex" << '\n';
+
+    for (size_t t = 1; t <= max_threads; t *= 2) {
+        std::cout << std::left << std::setw(10) << t << std::fixed << std::setprecision(2);
+
+        /* SPSC only makes sense with one producer and one consumer */
+        if (t <= 2)
+            std::cout << std::setw(12) << run<SPSCRingDeque<size_t>>(t);
+        else
+            std::cout << std::setw(12) << "-";
+
+        std::cout << std::setw(12) << run<MPMCRingDeque<size_t>>(t)
+                  << std::setw(12) << run<LockedArrayDeque>(t) << '\n';
+    }
+
+    return 0;
+}
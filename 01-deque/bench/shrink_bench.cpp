@@ -0,0 +1,60 @@
+#include <iostream>
+#include <iomanip>
+#include <random>
+
+#include "deque.hpp"
+
+/* Memory over time under bursty traffic. A producer occasionally pushes a
+ * large burst, while a consumer drains the deque at a steady rate back down
+ * to a small backlog. Two deques see the same traffic: one with the default
+ * (shrinking) capacity management, and one that reserve()s the peak up front
+ * and so never gives memory back, like ArrayDeque used to behave.
+ * Usage: shrink_bench [ticks] */
+
+struct Record {
+    char payload[64];
+};
+
+int main(int argc, char* argv[]) {
+    size_t ticks = argc > 1 ? std::stoul(argv[1]) : 200;
+    const size_t burst = 1 << 20;
+    const size_t drain_per_tick = 1 << 17;
+
+    ArrayDeque<Record> shrinking;
+    ArrayDeque<Record> pinned;
+    pinned.reserve(2 * burst);
+
+    std::mt19937 gen(42);
+    std::bernoulli_distribution burst_now(0.05);
+
+    std::cout << std::left << std::setw(8) << "tick" << std::setw(12) << "items"
+              << std::setw(16) << "shrinking MiB" << std::setw(16) << "pinned MiB" << '\n';
+
+    size_t shrinking_sum = 0, pinned_sum = 0;
+    for (size_t t = 0; t < ticks; t++) {
+        size_t incoming = 64 + (burst_now(gen) ? burst : 0);
+        for (size_t i = 0; i < incoming; i++) {
+            shrinking.push_back(Record{});
+            pinned.push_back(Record{});
+        }
+
+        for (size_t i = 0; i < drain_per_tick && shrinking.size() > 256; i++) {
+            shrinking.remove_front();
+            pinned.remove_front();
+        }
+
+        size_t a = shrinking.capacity() * sizeof(Record);
+        size_t b = pinned.capacity() * sizeof(Record);
+        shrinking_sum += a;
+        pinned_sum += b;
+
+        if (t % 5 == 0)
+            std::cout << std::left << std::setw(8) << t << std::setw(12) << shrinking.size()
+                      << std::fixed << std::setprecision(2)
+                      << std::setw(16) << a / 1048576.0 << std::setw(16) << b / 1048576.0 << '\n';
+    }
+
+    std::cout << "average MiB: shrinking " << shrinking_sum / ticks / 1048576.0
+              << ", pinned " << pinned_sum / ticks / 1048576.0 << '\n';
+    return 0;
+}
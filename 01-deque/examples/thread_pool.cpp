@@ -0,0 +1,129 @@
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "work_stealing_deque.hpp"
+
+/* Usage: thread_pool [n] [workers]
+ *
+ * A small fork-join thread pool on top of WorkStealingDeque.
+ *
+ * Every worker owns a deque. Spawned tasks go to the back of the spawning
+ * worker's deque; a worker runs its own tasks from the back (newest first,
+ * which keeps the working set hot) and, when it runs dry, steals the oldest
+ * task of another worker. The thread that creates the pool is worker 0. */
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t n);
+    ~ThreadPool();
+
+    template <typename F>
+    void spawn(F&& f);
+
+    /* Keep running tasks until `pending` drops to zero */
+    void wait_for(const std::atomic<int>& pending);
+
+private:
+    using Task = std::function<void()>;
+
+    std::vector<std::unique_ptr<WorkStealingDeque<Task*>>> deques;
+    std::vector<std::thread> threads;
+    std::atomic<bool> stop{false};
+
+    static thread_local size_t self;
+
+    bool run_one();
+};
+
+thread_local size_t ThreadPool::self = 0;
+
+ThreadPool::ThreadPool(size_t n) {
+    for (size_t i = 0; i < n; i++)
+        deques.emplace_back(std::make_unique<WorkStealingDeque<Task*>>());
+
+    self = 0;
+    for (size_t i = 1; i < n; i++) {
+        threads.emplace_back([this, i] {
+            self = i;
+            while (!stop.load(std::memory_order_relaxed))
+                if (!run_one())
+                    std::this_thread::yield();
+        });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    stop = true;
+    for (auto& t : threads)
+        t.join();
+}
+
+template <typename F>
+void ThreadPool::spawn(F&& f) {
+    deques[self]->push_back(new Task(std::forward<F>(f)));
+}
+
+void ThreadPool::wait_for(const std::atomic<int>& pending) {
+    while (pending.load(std::memory_order_acquire) > 0)
+        if (!run_one())
+            std::this_thread::yield();
+}
+
+bool ThreadPool::run_one() {
+    std::optional<Task*> task = deques[self]->remove_back();
+
+    for (size_t k = 1; !task && k < deques.size(); k++)
+        task = deques[(self + k) % deques.size()]->steal();
+
+    if (!task)
+        return false;
+
+    (**task)();
+    delete *task;
+    return true;
+}
+
+long fib_sequential(int n) {
+    return n < 2 ? n : fib_sequential(n - 1) + fib_sequential(n - 2);
+}
+
+long fib(ThreadPool& pool, int n) {
+    if (n < 20)
+        return fib_sequential(n);
+
+    long a, b;
+    std::atomic<int> pending{1};
+
+    pool.spawn([&] {
+        a = fib(pool, n - 1);
+        pending.fetch_sub(1, std::memory_order_release);
+    });
+    b = fib(pool, n - 2);
+
+    pool.wait_for(pending);
+    return a + b;
+}
+
+int main(int argc, char *argv[]) {
+    int n = argc > 1 ? std::stoi(argv[1]) : 36;
+    size_t workers = argc > 2 ? std::stoul(argv[2])
+                              : std::max(1u, std::thread::hardware_concurrency());
+
+    auto start = std::chrono::steady_clock::now();
+    long expected = fib_sequential(n);
+    std::chrono::duration<double> sequential = std::chrono::steady_clock::now() - start;
+
+    ThreadPool pool(workers);
+    start = std::chrono::steady_clock::now();
+    long result = fib(pool, n);
+    std::chrono::duration<double> parallel = std::chrono::steady_clock::now() - start;
+
+    std::cout << "fib(" << n << ") = " << result
+              << (result == expected ? "" : " (WRONG)") << '\n'
+              << "sequential: " << sequential.count() << "s\n"
+              << workers << " workers: " << parallel.count() << "s\n";
+    return result == expected ? 0 : 1;
+}
@@ -0,0 +1,198 @@
+#ifndef _BLOCK_DEQUE_H
+#define _BLOCK_DEQUE_H
+
+#include <algorithm>
+#include <optional>
+#include <memory>
+
+#include "deque.hpp"
+
+/* Default block length: roughly 512 bytes per block, like libstdc++. */
+template <typename T>
+constexpr size_t block_deque_block_size() {
+    return sizeof(T) < 512 ? 512 / sizeof(T) : 1;
+}
+
+/* A segmented deque. Items live in fixed-size blocks, and a small "map" keeps
+ * the pointers to the blocks in order. Growing the deque only reallocates the
+ * map of block pointers; the items themselves never move.
+ *
+ * Slots are numbered from the beginning of the map, so the item at
+ * position `pos` lives in map[pos / BlockSize][pos % BlockSize].
+ * Only the blocks covering [start, start + size_) are allocated (plus at
+ * most one spare block when the deque becomes empty). Blocks are raw storage,
+ * so only live items are ever constructed.
+ */
+template <typename T, size_t BlockSize = block_deque_block_size<T>()>
+class BlockDeque {
+public:
+    using value_type = T;
+
+    BlockDeque();
+    ~BlockDeque();
+
+    void push_front(const T&);
+    void push_back(const T&);
+    void push_front(T&&);
+    void push_back(T&&);
+
+    template <typename... Args>
+    void emplace_front(Args&&...);
+    template <typename... Args>
+    void emplace_back(Args&&...);
+
+    std::optional<T> remove_front();
+    std::optional<T> remove_back();
+
+    bool empty();
+    size_t size();
+
+    T& operator[](size_t);
+
+private:
+    std::unique_ptr<RawStorage<T>[]> map;
+    size_t map_size_;
+    size_t start;
+    size_t size_;
+
+    T& slot(size_t pos) { return map[pos / BlockSize][pos % BlockSize]; }
+    void ensure_block(size_t pos);
+    void grow_map();
+};
+
+template <typename T, size_t BlockSize>
+BlockDeque<T, BlockSize>::BlockDeque() :
+    map_size_{8}, start{4 * BlockSize}, size_{0} {
+    map = std::make_unique<RawStorage<T>[]>(map_size_);
+}
+
+template <typename T, size_t BlockSize>
+BlockDeque<T, BlockSize>::~BlockDeque() {
+    for (size_t i = 0; i < size_; i++)
+        std::destroy_at(&slot(start + i));
+}
+
+template <typename T, size_t BlockSize>
+void BlockDeque<T, BlockSize>::ensure_block(size_t pos) {
+    auto& block = map[pos / BlockSize];
+    if (!block)
+        block = make_raw_storage<T>(BlockSize);
+}
+
+/* Called when one end of the map is exhausted. Block pointers in use are
+ * moved to the middle of a map, which is doubled only if it is more than
+ * half full. Either way, only pointers are copied. */
+template <typename T, size_t BlockSize>
+void BlockDeque<T, BlockSize>::grow_map() {
+    size_t first_block = start / BlockSize;
+    size_t last_block = std::min((start + size_) / BlockSize, map_size_ - 1);
+    size_t used = last_block - first_block + 1;
+
+    size_t new_map_size = map_size_;
+    if (used * 2 >= map_size_)
+        new_map_size = std::max(map_size_ * 2, used + 2);
+
+    auto new_map = std::make_unique<RawStorage<T>[]>(new_map_size);
+    size_t new_first_block = (new_map_size - used) / 2;
+    for (size_t i = 0; i < used; i++)
+        new_map[new_first_block + i] = std::move(map[first_block + i]);
+
+    start = new_first_block * BlockSize + start % BlockSize;
+    map = std::move(new_map);
+    map_size_ = new_map_size;
+}
+
+template <typename T, size_t BlockSize>
+void BlockDeque<T, BlockSize>::push_front(const T& item) {
+    emplace_front(item);
+}
+
+template <typename T, size_t BlockSize>
+void BlockDeque<T, BlockSize>::push_back(const T& item) {
+    emplace_back(item);
+}
+
+template <typename T, size_t BlockSize>
+void BlockDeque<T, BlockSize>::push_front(T&& item) {
+    emplace_front(std::move(item));
+}
+
+template <typename T, size_t BlockSize>
+void BlockDeque<T, BlockSize>::push_back(T&& item) {
+    emplace_back(std::move(item));
+}
+
+template <typename T, size_t BlockSize>
+template <typename... Args>
+void BlockDeque<T, BlockSize>::emplace_front(Args&&... args) {
+    if (start == 0)
+        grow_map();
+
+    size_t pos = start - 1;
+    ensure_block(pos);
+    ::new (static_cast<void*>(&slot(pos))) T(std::forward<Args>(args)...);
+    start = pos;
+    size_++;
+}
+
+template <typename T, size_t BlockSize>
+template <typename... Args>
+void BlockDeque<T, BlockSize>::emplace_back(Args&&... args) {
+    if (start + size_ == map_size_ * BlockSize)
+        grow_map();
+
+    size_t pos = start + size_;
+    ensure_block(pos);
+    ::new (static_cast<void*>(&slot(pos))) T(std::forward<Args>(args)...);
+    size_++;
+}
+
+template <typename T, size_t BlockSize>
+std::optional<T> BlockDeque<T, BlockSize>::remove_front() {
+    if (empty())
+        return std::nullopt;
+
+    std::optional<T> val = std::move(slot(start));
+    std::destroy_at(&slot(start));
+    start++;
+    size_--;
+
+    /* Release the block we just walked out of, unless it is the last one. */
+    if (start % BlockSize == 0 && size_ > 0)
+        map[start / BlockSize - 1].reset();
+
+    return val;
+}
+
+template <typename T, size_t BlockSize>
+std::optional<T> BlockDeque<T, BlockSize>::remove_back() {
+    if (empty())
+        return std::nullopt;
+
+    size_--;
+    size_t pos = start + size_;
+    std::optional<T> val = std::move(slot(pos));
+    std::destroy_at(&slot(pos));
+
+    if (pos % BlockSize == 0 && size_ > 0)
+        map[pos / BlockSize].reset();
+
+    return val;
+}
+
+template <typename T, size_t BlockSize>
+bool BlockDeque<T, BlockSize>::empty() {
+    return size_ == 0;
+}
+
+template <typename T, size_t BlockSize>
+size_t BlockDeque<T, BlockSize>::size() {
+    return size_;
+}
+
+template <typename T, size_t BlockSize>
+T& BlockDeque<T, BlockSize>::operator[](size_t idx) {
+    return slot(start + idx);
+}
+
+#endif // _BLOCK_DEQUE_H
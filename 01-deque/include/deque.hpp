@@ -8,20 +8,36 @@
 #include <iostream>
 #include <memory>
 #include <cassert>
+#include <utility>
+#include <new>
+#include <iterator>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <span>
+#include <vector>
+#include <concepts>
 
 /* NOTE: Deque, ArrayDeque, ListDeque Declaration modification is not allowed.
  * Fill in the TODO sections in the following code. */
 template <typename T>
 class Deque {
 public:
+    using value_type = T;
+
     virtual ~Deque() = default;
 
-    /* NOTE: We won't implement push functions that take rvalue references. */
     virtual void push_front(const T&) = 0;
     virtual void push_back(const T&) = 0;
 
+    /* Rvalue overloads let movable payloads (strings, vectors, ...) be
+       handed over without a deep copy. */
+    virtual void push_front(T&&) = 0;
+    virtual void push_back(T&&) = 0;
+
     /* NOTE: Unlike STL implementations which have separate `front` and
-       pop_front` functions, we have one unified method for removing an elem. */
+       pop_front` functions, we have one unified method for removing an elem.
+       The removed item is moved out of the deque, not copied. */
     virtual std::optional<T> remove_front() = 0;
     virtual std::optional<T> remove_back() = 0;
 
@@ -31,77 +47,240 @@ public:
     virtual T& operator[](size_t) = 0;
 };
 
+/* The same operations as a concept. The deques below do not derive from
+ * Deque<T> and have no virtual functions: generic code constrained on
+ * DequeLike (e.g. Palindrome) calls the concrete type, and every call is
+ * bound statically and can be inlined. Code that needs to pick a deque at
+ * run time wraps it in a DequeAdapter and uses it as a Deque<T>&. */
+template <typename D>
+concept DequeLike = requires(D d, const typename D::value_type& v, size_t i) {
+    d.push_front(v);
+    d.push_back(v);
+    { d.remove_front() } -> std::same_as<std::optional<typename D::value_type>>;
+    { d.remove_back() } -> std::same_as<std::optional<typename D::value_type>>;
+    { d.empty() } -> std::convertible_to<bool>;
+    { d.size() } -> std::convertible_to<size_t>;
+    { d[i] } -> std::same_as<typename D::value_type&>;
+};
+
+/* Exposes any DequeLike type through the virtual interface, e.g.
+ * DequeAdapter<ArrayDeque<T>> is a Deque<T>. */
+template <DequeLike D>
+class DequeAdapter final : public Deque<typename D::value_type> {
+public:
+    using T = typename D::value_type;
+
+    template <typename... Args>
+    explicit DequeAdapter(Args&&... args) : deque(std::forward<Args>(args)...) {}
+
+    void push_front(const T& t) override { deque.push_front(t); }
+    void push_back(const T& t) override { deque.push_back(t); }
+    void push_front(T&& t) override { deque.push_front(std::move(t)); }
+    void push_back(T&& t) override { deque.push_back(std::move(t)); }
+
+    std::optional<T> remove_front() override { return deque.remove_front(); }
+    std::optional<T> remove_back() override { return deque.remove_back(); }
+
+    bool empty() override { return deque.empty(); }
+    size_t size() override { return deque.size(); }
+
+    T& operator[](size_t idx) override { return deque[idx]; }
+
+    D& get() { return deque; }
+
+private:
+    D deque;
+};
+
+/* Uninitialized, suitably aligned storage for items of type T. Nothing is
+ * constructed up front: the owner placement-news items into the slots it
+ * uses and destroys them itself. */
+template <typename T>
+struct RawStorageDeleter {
+    void operator()(T* p) const {
+        ::operator delete(static_cast<void*>(p), std::align_val_t{alignof(T)});
+    }
+};
+
+template <typename T>
+using RawStorage = std::unique_ptr<T[], RawStorageDeleter<T>>;
+
 template <typename T>
-class ArrayDeque : public Deque<T> {
+RawStorage<T> make_raw_storage(size_t n) {
+    void* p = ::operator new(n * sizeof(T), std::align_val_t{alignof(T)});
+    return RawStorage<T>(static_cast<T*>(p));
+}
+
+/* The capacity of an ArrayDeque is always a power of two (64, doubled on
+ * every resize), so physical positions wrap with `& (capacity_ - 1)` instead
+ * of comparisons. `front` is the slot before the first item and `back` is the
+ * slot after the last one.
+ *
+ * The buffer also shrinks: when a removal leaves it less than a quarter full,
+ * it is halved (never below 64 slots, or what reserve() asked for). Growing
+ * happens when it is nearly full, so a deque hovering around one size does
+ * not bounce between two capacities. */
+template <typename T>
+class ArrayDeque {
 public:
+    using value_type = T;
+
+    template <bool Const>
+    class Iterator;
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
     ArrayDeque();
-    ~ArrayDeque() = default;
+    ~ArrayDeque();
 
-    void push_front(const T&) override;
-    void push_back(const T&) override;
+    void push_front(const T&);
+    void push_back(const T&);
+    void push_front(T&&);
+    void push_back(T&&);
 
-    std::optional<T> remove_front() override;
-    std::optional<T> remove_back() override;
+    template <typename... Args>
+    void emplace_front(Args&&...);
+    template <typename... Args>
+    void emplace_back(Args&&...);
 
-    bool empty() override;
-    size_t size() override;
+    std::optional<T> remove_front();
+    std::optional<T> remove_back();
+
+    bool empty();
+    size_t size();
     size_t capacity();
 
-    T& operator[](size_t) override;
+    /* Make room for `n` items without reallocating; automatic shrinking will
+       not go below that either. shrink_to_fit() drops any reservation and
+       shrinks the buffer to the smallest capacity that fits the items. */
+    void reserve(size_t n);
+    void shrink_to_fit();
+
+    T& operator[](size_t);
+
+    iterator begin() { return iterator{arr.get(), capacity_ - 1, front + 1, 0}; }
+    iterator end() { return iterator{arr.get(), capacity_ - 1, front + 1, size_}; }
+    const_iterator begin() const { return const_iterator{arr.get(), capacity_ - 1, front + 1, 0}; }
+    const_iterator end() const { return const_iterator{arr.get(), capacity_ - 1, front + 1, size_}; }
+
+    /* The items as (at most) two contiguous parts of the buffer. The first
+       part starts at the front item; the second one holds the items that
+       wrapped around to the beginning of the buffer, and may be empty. */
+    std::span<T> as_array_one();
+    std::span<T> as_array_two();
+
+    /* Bulk operations. They fall back to memcpy when T is trivially
+       copyable and the other side is contiguous memory. */
+    template <typename InputIt>
+    void push_back_range(InputIt first, InputIt last);
+    template <typename OutputIt>
+    OutputIt remove_front_n(size_t n, OutputIt out);
 
 private:
-    std::unique_ptr<T[]> arr;
+    RawStorage<T> arr;
     size_t front;
     size_t back;
     size_t size_;
     size_t capacity_;
+    size_t min_capacity_;
 
     void resize();
+    void shrink_if_sparse();
+    void relocate(size_t new_capacity);
+    static size_t capacity_for(size_t n);
 };
 
 template <typename T>
 ArrayDeque<T>::ArrayDeque() :
     front{63 /* You can change this */},
     back{0 /* You can change this */},
-    size_{0}, capacity_{64} {
-    arr = std::make_unique<T[]>(capacity_);
+    size_{0}, capacity_{64}, min_capacity_{64} {
+    arr = make_raw_storage<T>(capacity_);
+}
+
+template <typename T>
+ArrayDeque<T>::~ArrayDeque() {
+    while (!empty())
+        remove_back();
 }
 
 template <typename T>
 void ArrayDeque<T>::push_front(const T& item) {
+    emplace_front(item);
+}
+
+template <typename T>
+void ArrayDeque<T>::push_back(const T& item) {
+    emplace_back(item);
+}
+
+template <typename T>
+void ArrayDeque<T>::push_front(T&& item) {
+    emplace_front(std::move(item));
+}
+
+template <typename T>
+void ArrayDeque<T>::push_back(T&& item) {
+    emplace_back(std::move(item));
+}
+
+template <typename T>
+template <typename... Args>
+void ArrayDeque<T>::emplace_front(Args&&... args) {
 	// TODO
+	::new (static_cast<void*>(&arr[front])) T(std::forward<Args>(args)...);
 	size_++;
-	arr[front] = item;
-    if(front == 0) front = capacity_;
-    front--;   
-
-    if(size_ == capacity_ - 2)
-        resize();
+    front = (front - 1) & (capacity_ - 1);
+
+    if(size_ == capacity_ - 2) {
+        /* A failed resize takes the new item out again, so that the deque
+           is as it was and size_ stays below capacity_ - 2 */
+        try {
+            resize();
+        } catch (...) {
+            front = (front + 1) & (capacity_ - 1);
+            std::destroy_at(&arr[front]);
+            size_--;
+            throw;
+        }
+    }
 }
 
 template <typename T>
-void ArrayDeque<T>::push_back(const T& item) {
+template <typename... Args>
+void ArrayDeque<T>::emplace_back(Args&&... args) {
     // TODO
+    ::new (static_cast<void*>(&arr[back])) T(std::forward<Args>(args)...);
     size_++;
-    arr[back] = item;
-    back++;
-	if(back == capacity_) back = 0;
-
-    if(size_ == capacity_ - 2)
-        resize();
+    back = (back + 1) & (capacity_ - 1);
+
+    if(size_ == capacity_ - 2) {
+        /* A failed resize takes the new item out again, so that the deque
+           is as it was and size_ stays below capacity_ - 2 */
+        try {
+            resize();
+        } catch (...) {
+            back = (back - 1) & (capacity_ - 1);
+            std::destroy_at(&arr[back]);
+            size_--;
+            throw;
+        }
+    }
 }
 
+/* The removed item is moved out and its slot destroyed right away. */
 template <typename T>
 std::optional<T> ArrayDeque<T>::remove_front() {
     // TODO
 	if( !empty() ){
         size_--;
-		if(front == capacity_-1) {
-            front = 0;
-            return arr[front];
-        }
-        front++;
-		return arr[front];
+        front = (front + 1) & (capacity_ - 1);
+
+        std::optional<T> val = std::move(arr[front]);
+        std::destroy_at(&arr[front]);
+        shrink_if_sparse();
+		return val;
 	}
     return std::nullopt;
 }
@@ -111,12 +290,12 @@ std::optional<T> ArrayDeque<T>::remove_back() {
     // TODO
     if ( !empty() ){
         size_--;
-        if(back == 0){
-            back = capacity_-1;
-            return arr[back];
-        }
-        back--;
-        return arr[back];
+        back = (back - 1) & (capacity_ - 1);
+
+        std::optional<T> val = std::move(arr[back]);
+        std::destroy_at(&arr[back]);
+        shrink_if_sparse();
+        return val;
     }
     return std::nullopt;
 }
@@ -124,32 +303,131 @@ std::optional<T> ArrayDeque<T>::remove_back() {
 template <typename T>
 void ArrayDeque<T>::resize() {
     // TODO
-    int capacity_before = capacity_;
-    capacity_ *= 2;
+    relocate(capacity_ * 2);
+}
 
-    // make a same array brr as arr (before resizing)
-    std::unique_ptr<T[]> brr = std::make_unique<T[]>(capacity_before);
-    for(int i = 0; i < capacity_before; i++){
-        brr[i] = arr[i];
-    }
+template <typename T>
+void ArrayDeque<T>::shrink_if_sparse() {
+    size_t c = capacity_;
+    while (c > min_capacity_ && size_ < c / 4)
+        c /= 2;
 
-    arr = std::make_unique<T[]>(capacity_);
+    if (c != capacity_)
+        relocate(c);
+}
 
-    if(front > back){
-        for(int i = front + 1; i < capacity_before; i++)
-            arr[capacity_before + i] = brr[i];
-        
-        for(int i = 0; i < back; i++)
-            arr[i] = brr[i];
+/* The smallest capacity that holds `n` items without triggering resize() */
+template <typename T>
+size_t ArrayDeque<T>::capacity_for(size_t n) {
+    size_t c = 64;
+    while (n >= c - 2)
+        c *= 2;
+    return c;
+}
+
+template <typename T>
+void ArrayDeque<T>::reserve(size_t n) {
+    min_capacity_ = capacity_for(n);
+    if (min_capacity_ > capacity_)
+        relocate(min_capacity_);
+}
+
+template <typename T>
+void ArrayDeque<T>::shrink_to_fit() {
+    min_capacity_ = 64;
+    size_t c = capacity_for(size_);
+    if (c < capacity_)
+        relocate(c);
+}
 
-        front += capacity_before;
+/* Move the items, in order, to the beginning of a new buffer.
+ * Every live item is moved exactly once and the old slots are destroyed.
+ * Items whose move may throw are copied instead (move_if_noexcept), and the
+ * old ones are only destroyed once every copy is in place: if a copy throws,
+ * the copies made so far are destroyed and the deque is left as it was. */
+template <typename T>
+void ArrayDeque<T>::relocate(size_t new_capacity) {
+    RawStorage<T> brr = make_raw_storage<T>(new_capacity);
+
+    size_t i = 0;
+    try {
+        for (; i < size_; i++)
+            ::new (static_cast<void*>(&brr[i])) T(std::move_if_noexcept((*this)[i]));
+    } catch (...) {
+        std::destroy_n(brr.get(), i);
+        throw;
     }
 
-    else if(front < back){
-        for(int i = front + 1; i <= back - 1; i++)
-            arr[i] = brr[i];
+    for (i = 0; i < size_; i++)
+        std::destroy_at(&(*this)[i]);
+
+    arr = std::move(brr);
+    capacity_ = new_capacity;
+    front = capacity_ - 1;
+    back = size_;
+}
+
+template <typename T>
+std::span<T> ArrayDeque<T>::as_array_one() {
+    size_t head = (front + 1) & (capacity_ - 1);
+    return { arr.get() + head, std::min(size_, capacity_ - head) };
+}
+
+template <typename T>
+std::span<T> ArrayDeque<T>::as_array_two() {
+    size_t head = (front + 1) & (capacity_ - 1);
+    return { arr.get(), size_ - std::min(size_, capacity_ - head) };
+}
+
+template <typename T>
+template <typename InputIt>
+void ArrayDeque<T>::push_back_range(InputIt first, InputIt last) {
+    if constexpr (std::forward_iterator<InputIt>) {
+        size_t n = std::distance(first, last);
+
+        /* Grow once, keeping the invariant that size_ < capacity_ - 2. */
+        size_t new_capacity = capacity_for(size_ + n);
+        if (new_capacity > capacity_)
+            relocate(new_capacity);
+
+        if constexpr (std::contiguous_iterator<InputIt> &&
+                      std::is_trivially_copyable_v<T> &&
+                      std::is_same_v<std::iter_value_t<InputIt>, T>) {
+            const T* src = std::to_address(first);
+            size_t len_one = std::min(n, capacity_ - back);
+
+            std::memcpy(arr.get() + back, src, len_one * sizeof(T));
+            std::memcpy(arr.get(), src + len_one, (n - len_one) * sizeof(T));
+            back = (back + n) & (capacity_ - 1);
+            size_ += n;
+            return;
+        }
     }
 
+    for (; first != last; ++first)
+        emplace_back(*first);
+}
+
+template <typename T>
+template <typename OutputIt>
+OutputIt ArrayDeque<T>::remove_front_n(size_t n, OutputIt out) {
+    n = std::min(n, size_);
+
+    if constexpr (std::is_trivially_copyable_v<T> && std::is_same_v<OutputIt, T*>) {
+        std::span<T> one = as_array_one();
+        size_t len_one = std::min(n, one.size());
+
+        std::memcpy(out, one.data(), len_one * sizeof(T));
+        std::memcpy(out + len_one, arr.get(), (n - len_one) * sizeof(T));
+        front = (front + n) & (capacity_ - 1);
+        size_ -= n;
+        shrink_if_sparse();
+        return out + n;
+    } else {
+        for (size_t i = 0; i < n; i++)
+            *out++ = std::move(*remove_front());
+        return out;
+    }
 }
 
 template <typename T>
@@ -174,19 +452,66 @@ size_t ArrayDeque<T>::capacity() {
 template <typename T>
 T& ArrayDeque<T>::operator[](size_t idx) {
     // TODO
-    if(front < back){
-        return arr[front + idx + 1];
-    }
-    else{
-        if(idx >= capacity_ - front - 1){
-            return arr[idx - capacity_ + front + 1];
-        }
-        else {
-            return arr[front + idx + 1];
-        }
-    }
+    return arr[(front + 1 + idx) & (capacity_ - 1)];
 }
 
+/* A random access iterator over the items of an ArrayDeque, from front to
+ * back. It stores the logical index and wraps it on dereference, so it is
+ * invalidated by resize() like pointers into the buffer would be. */
+template <typename T>
+template <bool Const>
+class ArrayDeque<T>::Iterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const T*, T*>;
+    using reference = std::conditional_t<Const, const T&, T&>;
+
+    Iterator() = default;
+    Iterator(pointer arr, size_t mask, size_t head, size_t idx)
+        : arr(arr), mask(mask), head(head), idx(idx) {}
+
+    /* iterator -> const_iterator */
+    template <bool C = Const, typename = std::enable_if_t<C>>
+    Iterator(const Iterator<false>& it)
+        : arr(it.arr), mask(it.mask), head(it.head), idx(it.idx) {}
+
+    reference operator*() const { return arr[(head + idx) & mask]; }
+    pointer operator->() const { return &**this; }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    Iterator& operator++() { idx++; return *this; }
+    Iterator& operator--() { idx--; return *this; }
+    Iterator operator++(int) { Iterator it = *this; idx++; return it; }
+    Iterator operator--(int) { Iterator it = *this; idx--; return it; }
+
+    Iterator& operator+=(difference_type n) { idx += n; return *this; }
+    Iterator& operator-=(difference_type n) { idx -= n; return *this; }
+
+    friend Iterator operator+(Iterator it, difference_type n) { return it += n; }
+    friend Iterator operator+(difference_type n, Iterator it) { return it += n; }
+    friend Iterator operator-(Iterator it, difference_type n) { return it -= n; }
+    friend difference_type operator-(const Iterator& a, const Iterator& b) {
+        return static_cast<difference_type>(a.idx - b.idx);
+    }
+
+    friend bool operator==(const Iterator& a, const Iterator& b) { return a.idx == b.idx; }
+    friend bool operator!=(const Iterator& a, const Iterator& b) { return a.idx != b.idx; }
+    friend bool operator<(const Iterator& a, const Iterator& b) { return a.idx < b.idx; }
+    friend bool operator>(const Iterator& a, const Iterator& b) { return a.idx > b.idx; }
+    friend bool operator<=(const Iterator& a, const Iterator& b) { return a.idx <= b.idx; }
+    friend bool operator>=(const Iterator& a, const Iterator& b) { return a.idx >= b.idx; }
+
+private:
+    template <bool> friend class Iterator;
+
+    pointer arr = nullptr;
+    size_t mask = 0;
+    size_t head = 0;
+    size_t idx = 0;
+};
+
 template<typename T>
 struct ListNode {
     std::optional<T> value;
@@ -196,38 +521,148 @@ struct ListNode {
     ListNode() : value(std::nullopt), prev(this), next(this) {}
     ListNode(const T& t) : value(t), prev(this), next(this) {}
 
+    template <typename... Args>
+    ListNode(std::in_place_t, Args&&... args)
+        : value(std::in_place, std::forward<Args>(args)...), prev(this), next(this) {}
+
     ListNode(const ListNode&) = delete;
 };
 
-template<typename T>
-class ListDeque : public Deque<T> {
+/* Node allocators for ListDeque. They create and destroy whole nodes.
+ *
+ * HeapNodeAllocator gets every node from new/delete.
+ *
+ * PooledNodeAllocator carves nodes out of chunks of `ChunkSize` slots, and
+ * destroyed nodes go to a free list to be reused by the next push, so a
+ * deque under steady churn does not call malloc at all. Memory goes back to
+ * the heap only when the allocator (i.e. the deque) is destroyed. */
+template<typename Node>
+struct HeapNodeAllocator {
+    template<typename... Args>
+    Node* create(Args&&... args) { return new Node(std::forward<Args>(args)...); }
+
+    void destroy(Node* node) { delete node; }
+};
+
+template<typename Node, size_t ChunkSize = 128>
+class PooledNodeAllocator {
 public:
+    PooledNodeAllocator() = default;
+    PooledNodeAllocator(const PooledNodeAllocator&) = delete;
+    PooledNodeAllocator& operator=(const PooledNodeAllocator&) = delete;
+
+    template<typename... Args>
+    Node* create(Args&&... args);
+
+    void destroy(Node* node);
+
+private:
+    union Slot {
+        Slot* next;
+        alignas(Node) unsigned char storage[sizeof(Node)];
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> chunks;
+    Slot* free_list = nullptr;
+    size_t used_in_last_chunk = ChunkSize;
+};
+
+template<typename Node, size_t ChunkSize>
+template<typename... Args>
+Node* PooledNodeAllocator<Node, ChunkSize>::create(Args&&... args) {
+    Slot* slot;
+
+    if (free_list) {
+        slot = free_list;
+        free_list = slot->next;
+    } else {
+        if (used_in_last_chunk == ChunkSize) {
+            chunks.emplace_back(std::make_unique<Slot[]>(ChunkSize));
+            used_in_last_chunk = 0;
+        }
+        slot = &chunks.back()[used_in_last_chunk++];
+    }
+
+    try {
+        return ::new (static_cast<void*>(slot->storage)) Node(std::forward<Args>(args)...);
+    } catch (...) {
+        slot->next = free_list;
+        free_list = slot;
+        throw;
+    }
+}
+
+template<typename Node, size_t ChunkSize>
+void PooledNodeAllocator<Node, ChunkSize>::destroy(Node* node) {
+    std::destroy_at(node);
+
+    Slot* slot = reinterpret_cast<Slot*>(node);
+    slot->next = free_list;
+    free_list = slot;
+}
+
+template<typename T, typename NodeAllocator = PooledNodeAllocator<ListNode<T>>>
+class ListDeque {
+public:
+    using value_type = T;
+
     ListDeque();
     ~ListDeque();
 
-    void push_front(const T&) override;
-    void push_back(const T&) override;
+    void push_front(const T&);
+    void push_back(const T&);
+    void push_front(T&&);
+    void push_back(T&&);
 
-    std::optional<T> remove_front() override;
-    std::optional<T> remove_back() override;
+    template <typename... Args>
+    void emplace_front(Args&&...);
+    template <typename... Args>
+    void emplace_back(Args&&...);
 
-    bool empty() override;
-    size_t size() override;
+    std::optional<T> remove_front();
+    std::optional<T> remove_back();
 
-    T& operator[](size_t) override;
+    bool empty();
+    size_t size();
+
+    T& operator[](size_t);
 
     size_t size_ = 0;
     ListNode<T>* sentinel = nullptr;
+
+private:
+    NodeAllocator nodes;
 };
 
-template<typename T>
-ListDeque<T>::ListDeque() : sentinel(new ListNode<T>{}), size_(0) {}
+template<typename T, typename NodeAllocator>
+ListDeque<T, NodeAllocator>::ListDeque() : sentinel(new ListNode<T>{}), size_(0) {}
 
-template<typename T>
-void ListDeque<T>::push_front(const T& t) {
+template<typename T, typename NodeAllocator>
+void ListDeque<T, NodeAllocator>::push_front(const T& t) {
+    emplace_front(t);
+}
+
+template<typename T, typename NodeAllocator>
+void ListDeque<T, NodeAllocator>::push_back(const T& t) {
+    emplace_back(t);
+}
+
+template<typename T, typename NodeAllocator>
+void ListDeque<T, NodeAllocator>::push_front(T&& t) {
+    emplace_front(std::move(t));
+}
+
+template<typename T, typename NodeAllocator>
+void ListDeque<T, NodeAllocator>::push_back(T&& t) {
+    emplace_back(std::move(t));
+}
+
+template<typename T, typename NodeAllocator>
+template<typename... Args>
+void ListDeque<T, NodeAllocator>::emplace_front(Args&&... args) {
     // TODO
+    ListNode<T>* insert_node = nodes.create(std::in_place, std::forward<Args>(args)...);
     size_++;
-    ListNode<T>* insert_node = new ListNode(t);
 
     if(size_ == 1){
         sentinel->prev = insert_node;
@@ -245,11 +680,12 @@ void ListDeque<T>::push_front(const T& t) {
     }
 }
 
-template<typename T>
-void ListDeque<T>::push_back(const T& t) {
+template<typename T, typename NodeAllocator>
+template<typename... Args>
+void ListDeque<T, NodeAllocator>::emplace_back(Args&&... args) {
     // TODO
+    ListNode<T>* insert_node = nodes.create(std::in_place, std::forward<Args>(args)...);
     size_++;
-    ListNode<T>* insert_node = new ListNode(t);
 
     if(size_ == 1){
         sentinel->prev = insert_node;
@@ -268,8 +704,8 @@ void ListDeque<T>::push_back(const T& t) {
     
 }
 
-template<typename T>
-std::optional<T> ListDeque<T>::remove_front() {
+template<typename T, typename NodeAllocator>
+std::optional<T> ListDeque<T, NodeAllocator>::remove_front() {
     // TODO
     if(size_ >= 1) {
         size_--;
@@ -277,15 +713,15 @@ std::optional<T> ListDeque<T>::remove_front() {
         ListNode<T>* second_node = first_node->next;
         sentinel->next = second_node;
         second_node->prev = sentinel;
-        std::optional<T> val = first_node->value.value();
-        delete first_node;
+        std::optional<T> val = std::move(first_node->value);
+        nodes.destroy(first_node);
         return val;
     }
     else return std::nullopt;
 }
 
-template<typename T>
-std::optional<T> ListDeque<T>::remove_back() {
+template<typename T, typename NodeAllocator>
+std::optional<T> ListDeque<T, NodeAllocator>::remove_back() {
     // TODO
     if(size_ >= 1) {
         size_--;
@@ -293,28 +729,28 @@ std::optional<T> ListDeque<T>::remove_back() {
         ListNode<T>* second_node = first_node->prev;
         sentinel->prev = second_node;
         second_node->next = sentinel;
-        std::optional<T> val = first_node->value.value();
-        delete first_node;
+        std::optional<T> val = std::move(first_node->value);
+        nodes.destroy(first_node);
         return val;
     }
     else return std::nullopt;
 }
 
-template<typename T>
-bool ListDeque<T>::empty() {
+template<typename T, typename NodeAllocator>
+bool ListDeque<T, NodeAllocator>::empty() {
     // TODO
     if(size_ == 0) return true;
     return false;
 }
 
-template<typename T>
-size_t ListDeque<T>::size() {
+template<typename T, typename NodeAllocator>
+size_t ListDeque<T, NodeAllocator>::size() {
     // TODO
     return size_;
 }
 
-template<typename T>
-T& ListDeque<T>::operator[](size_t idx) {
+template<typename T, typename NodeAllocator>
+T& ListDeque<T, NodeAllocator>::operator[](size_t idx) {
     // TODO
     auto temp = sentinel;
     idx++;
@@ -332,8 +768,8 @@ std::ostream& operator<<(std::ostream& os, const ListNode<T>& n) {
     return os;
 }
 
-template<typename T>
-std::ostream& operator<<(std::ostream& os, const ListDeque<T>& l) {
+template<typename T, typename NodeAllocator>
+std::ostream& operator<<(std::ostream& os, const ListDeque<T, NodeAllocator>& l) {
     auto np = l.sentinel->next;
     while (np != l.sentinel) {
         os << *np << ' ';
@@ -343,14 +779,14 @@ std::ostream& operator<<(std::ostream& os, const ListDeque<T>& l) {
     return os;
 }
 
-template<typename T>
-ListDeque<T>::~ListDeque() {
+template<typename T, typename NodeAllocator>
+ListDeque<T, NodeAllocator>::~ListDeque() {
     // TODO
     if(!empty()){
         ListNode<T>* deleting_node = sentinel->next;
         while(deleting_node != NULL){
             ListNode<T>* next_node = deleting_node->next;
-            delete deleting_node;
+            nodes.destroy(deleting_node);
             if(next_node == sentinel) break;
             deleting_node = next_node;
         }
@@ -0,0 +1,239 @@
+#ifndef _RING_DEQUE_H
+#define _RING_DEQUE_H
+
+#include <atomic>
+#include <optional>
+#include <memory>
+#include <new>
+
+#include "deque.hpp"
+
+/* Bounded, lock-free ring buffers for passing items between threads.
+ *
+ * Like ArrayDeque, they index a power-of-two buffer with a mask. Here `front`
+ * and `back` are never wrapped: they count the items removed and pushed so
+ * far, and the slot of an index is `index & mask`. Items go in at the back
+ * and come out at the front.
+ *
+ * push_back() returns false instead of growing when the ring is full, and
+ * remove_front() returns std::nullopt when it is empty.
+ */
+
+/* Indices written by different threads live on different cache lines. */
+constexpr size_t cache_line_size = 64;
+
+inline size_t ring_capacity_for(size_t capacity) {
+    size_t c = 2;
+    while (c < capacity)
+        c *= 2;
+    return c;
+}
+
+/* Single producer, single consumer. Each side keeps a private copy of the
+ * other side's index and reloads it only when the ring looks full (or
+ * empty), so the shared cache lines are touched as rarely as possible. */
+template <typename T>
+class SPSCRingDeque {
+public:
+    explicit SPSCRingDeque(size_t capacity = 1024);
+    ~SPSCRingDeque();
+
+    SPSCRingDeque(const SPSCRingDeque&) = delete;
+    SPSCRingDeque& operator=(const SPSCRingDeque&) = delete;
+
+    /* Producer side */
+    bool push_back(const T& item) { return emplace_back(item); }
+    bool push_back(T&& item) { return emplace_back(std::move(item)); }
+    template <typename... Args>
+    bool emplace_back(Args&&...);
+
+    /* Consumer side */
+    std::optional<T> remove_front();
+
+    /* Approximate when the other side is running */
+    size_t size() const;
+    bool empty() const { return size() == 0; }
+    size_t capacity() const { return mask + 1; }
+
+private:
+    RawStorage<T> arr;
+    const size_t mask;
+
+    alignas(cache_line_size) std::atomic<size_t> front{0};
+    size_t cached_back = 0;
+
+    alignas(cache_line_size) std::atomic<size_t> back{0};
+    size_t cached_front = 0;
+};
+
+template <typename T>
+SPSCRingDeque<T>::SPSCRingDeque(size_t capacity)
+    : arr(make_raw_storage<T>(ring_capacity_for(capacity))),
+      mask(ring_capacity_for(capacity) - 1) {}
+
+template <typename T>
+SPSCRingDeque<T>::~SPSCRingDeque() {
+    while (remove_front())
+        ;
+}
+
+template <typename T>
+template <typename... Args>
+bool SPSCRingDeque<T>::emplace_back(Args&&... args) {
+    size_t b = back.load(std::memory_order_relaxed);
+
+    if (b - cached_front > mask) {
+        cached_front = front.load(std::memory_order_acquire);
+        if (b - cached_front > mask)
+            return false;
+    }
+
+    ::new (static_cast<void*>(&arr[b & mask])) T(std::forward<Args>(args)...);
+    back.store(b + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+std::optional<T> SPSCRingDeque<T>::remove_front() {
+    size_t f = front.load(std::memory_order_relaxed);
+
+    if (f == cached_back) {
+        cached_back = back.load(std::memory_order_acquire);
+        if (f == cached_back)
+            return std::nullopt;
+    }
+
+    T& slot = arr[f & mask];
+    std::optional<T> val = std::move(slot);
+    std::destroy_at(&slot);
+    front.store(f + 1, std::memory_order_release);
+    return val;
+}
+
+template <typename T>
+size_t SPSCRingDeque<T>::size() const {
+    size_t f = front.load(std::memory_order_acquire);
+    size_t b = back.load(std::memory_order_acquire);
+    return b - f;
+}
+
+/* Multiple producers, multiple consumers (Vyukov's bounded queue).
+ *
+ * Each slot carries a sequence number telling which lap of the ring it is
+ * ready for. A producer claims index `i` with a CAS on `back` once the slot
+ * says `i` (empty for this lap), and publishes the item by setting it to
+ * `i + 1`. A consumer claims index `i` with a CAS on `front` once the slot
+ * says `i + 1`, and hands the slot to the next lap by setting it to
+ * `i + capacity`. */
+template <typename T>
+class MPMCRingDeque {
+public:
+    explicit MPMCRingDeque(size_t capacity = 1024);
+    ~MPMCRingDeque();
+
+    MPMCRingDeque(const MPMCRingDeque&) = delete;
+    MPMCRingDeque& operator=(const MPMCRingDeque&) = delete;
+
+    bool push_back(const T& item) { return emplace_back(item); }
+    bool push_back(T&& item) { return emplace_back(std::move(item)); }
+    template <typename... Args>
+    bool emplace_back(Args&&...);
+
+    std::optional<T> remove_front();
+
+    /* Approximate when other threads are running */
+    size_t size() const;
+    bool empty() const { return size() == 0; }
+    size_t capacity() const { return mask + 1; }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* item() { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    const size_t mask;
+
+    alignas(cache_line_size) std::atomic<size_t> front{0};
+    alignas(cache_line_size) std::atomic<size_t> back{0};
+};
+
+template <typename T>
+MPMCRingDeque<T>::MPMCRingDeque(size_t capacity)
+    : slots(std::make_unique<Slot[]>(ring_capacity_for(capacity))),
+      mask(ring_capacity_for(capacity) - 1) {
+    for (size_t i = 0; i <= mask; i++)
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+template <typename T>
+MPMCRingDeque<T>::~MPMCRingDeque() {
+    while (remove_front())
+        ;
+}
+
+template <typename T>
+template <typename... Args>
+bool MPMCRingDeque<T>::emplace_back(Args&&... args) {
+    size_t b = back.load(std::memory_order_relaxed);
+    Slot* slot;
+
+    while (true) {
+        slot = &slots[b & mask];
+        size_t seq = slot->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(seq - b);
+
+        if (diff == 0) {
+            if (back.compare_exchange_weak(b, b + 1, std::memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            /* The slot still holds an item from the previous lap */
+            return false;
+        } else {
+            b = back.load(std::memory_order_relaxed);
+        }
+    }
+
+    ::new (static_cast<void*>(slot->storage)) T(std::forward<Args>(args)...);
+    slot->sequence.store(b + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+std::optional<T> MPMCRingDeque<T>::remove_front() {
+    size_t f = front.load(std::memory_order_relaxed);
+    Slot* slot;
+
+    while (true) {
+        slot = &slots[f & mask];
+        size_t seq = slot->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(seq - (f + 1));
+
+        if (diff == 0) {
+            if (front.compare_exchange_weak(f, f + 1, std::memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            /* Nothing has been published in this slot for this lap yet */
+            return std::nullopt;
+        } else {
+            f = front.load(std::memory_order_relaxed);
+        }
+    }
+
+    std::optional<T> val = std::move(*slot->item());
+    std::destroy_at(slot->item());
+    slot->sequence.store(f + mask + 1, std::memory_order_release);
+    return val;
+}
+
+template <typename T>
+size_t MPMCRingDeque<T>::size() const {
+    size_t f = front.load(std::memory_order_acquire);
+    size_t b = back.load(std::memory_order_acquire);
+    return b > f ? b - f : 0;
+}
+
+#endif // _RING_DEQUE_H
@@ -0,0 +1,306 @@
+#ifndef _UNROLLED_DEQUE_H
+#define _UNROLLED_DEQUE_H
+
+#include <algorithm>
+#include <optional>
+#include <memory>
+#include <new>
+
+#include "deque.hpp"
+
+/* Default number of items per node: about 256 bytes of items. */
+template <typename T>
+constexpr size_t unrolled_node_capacity() {
+    return std::max<size_t>(4, 256 / sizeof(T));
+}
+
+/* An unrolled linked list: a circular doubly linked list (with a sentinel,
+ * like ListDeque) whose nodes each hold up to K items in a small array.
+ *
+ * The items of a node live at [lo, hi) of its array. Pushing at the front
+ * fills the first node downwards and pushing at the back fills the last node
+ * upwards; a new node is only allocated when the end node is full. Nodes that
+ * become empty are unlinked, so every node in the list holds at least one
+ * item, and one of them is kept aside for the next push.
+ *
+ * operator[] skips whole nodes and starts from whichever end is closer, so
+ * it takes O(min(i, n - i) / K) steps. Whole deques can be spliced in O(1).
+ */
+template <typename T, size_t K = unrolled_node_capacity<T>()>
+class UnrolledListDeque {
+public:
+    using value_type = T;
+
+    UnrolledListDeque();
+    ~UnrolledListDeque();
+
+    UnrolledListDeque(const UnrolledListDeque&) = delete;
+    UnrolledListDeque& operator=(const UnrolledListDeque&) = delete;
+
+    void push_front(const T&);
+    void push_back(const T&);
+    void push_front(T&&);
+    void push_back(T&&);
+
+    template <typename... Args>
+    void emplace_front(Args&&...);
+    template <typename... Args>
+    void emplace_back(Args&&...);
+
+    std::optional<T> remove_front();
+    std::optional<T> remove_back();
+
+    bool empty();
+    size_t size();
+
+    T& operator[](size_t);
+
+    /* Move all items of `other` to the back (front) of this deque. O(1). */
+    void splice_back(UnrolledListDeque& other);
+    void splice_front(UnrolledListDeque& other);
+
+private:
+    struct Link {
+        Link* prev;
+        Link* next;
+    };
+
+    struct Node : Link {
+        size_t lo = 0;
+        size_t hi = 0;
+        alignas(T) unsigned char storage[K * sizeof(T)];
+
+        T* at(size_t i) { return std::launder(reinterpret_cast<T*>(storage)) + i; }
+        size_t count() const { return hi - lo; }
+    };
+
+    Link sentinel;
+    size_t size_ = 0;
+    Node* spare = nullptr;
+
+    Node* first() { return static_cast<Node*>(sentinel.next); }
+    Node* last() { return static_cast<Node*>(sentinel.prev); }
+
+    Node* new_node(size_t pos);
+    void recycle(Node*);
+    static void link_after(Link* pos, Link* node);
+    static void unlink(Link* node);
+};
+
+template <typename T, size_t K>
+UnrolledListDeque<T, K>::UnrolledListDeque() {
+    sentinel.prev = &sentinel;
+    sentinel.next = &sentinel;
+}
+
+template <typename T, size_t K>
+UnrolledListDeque<T, K>::~UnrolledListDeque() {
+    while (sentinel.next != &sentinel) {
+        Node* node = first();
+        std::destroy(node->at(node->lo), node->at(node->hi));
+        unlink(node);
+        delete node;
+    }
+    delete spare;
+}
+
+template <typename T, size_t K>
+void UnrolledListDeque<T, K>::link_after(Link* pos, Link* node) {
+    node->prev = pos;
+    node->next = pos->next;
+    pos->next->prev = node;
+    pos->next = node;
+}
+
+template <typename T, size_t K>
+void UnrolledListDeque<T, K>::unlink(Link* node) {
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+}
+
+/* An empty node whose items will grow from `pos` */
+template <typename T, size_t K>
+typename UnrolledListDeque<T, K>::Node* UnrolledListDeque<T, K>::new_node(size_t pos) {
+    Node* node = spare ? spare : new Node;
+    spare = nullptr;
+    node->lo = node->hi = pos;
+    return node;
+}
+
+template <typename T, size_t K>
+void UnrolledListDeque<T, K>::recycle(Node* node) {
+    if (spare)
+        delete node;
+    else
+        spare = node;
+}
+
+template <typename T, size_t K>
+void UnrolledListDeque<T, K>::push_front(const T& item) {
+    emplace_front(item);
+}
+
+template <typename T, size_t K>
+void UnrolledListDeque<T, K>::push_back(const T& item) {
+    emplace_back(item);
+}
+
+template <typename T, size_t K>
+void UnrolledListDeque<T, K>::push_front(T&& item) {
+    emplace_front(std::move(item));
+}
+
+template <typename T, size_t K>
+void UnrolledListDeque<T, K>::push_back(T&& item) {
+    emplace_back(std::move(item));
+}
+
+template <typename T, size_t K>
+template <typename... Args>
+void UnrolledListDeque<T, K>::emplace_front(Args&&... args) {
+    if (sentinel.next != &sentinel && first()->lo > 0) {
+        Node* node = first();
+        ::new (static_cast<void*>(node->at(node->lo - 1))) T(std::forward<Args>(args)...);
+        node->lo--;
+    } else {
+        Node* node = new_node(K);
+        try {
+            ::new (static_cast<void*>(node->at(K - 1))) T(std::forward<Args>(args)...);
+        } catch (...) {
+            recycle(node);
+            throw;
+        }
+        node->lo--;
+        link_after(&sentinel, node);
+    }
+    size_++;
+}
+
+template <typename T, size_t K>
+template <typename... Args>
+void UnrolledListDeque<T, K>::emplace_back(Args&&... args) {
+    if (sentinel.prev != &sentinel && last()->hi < K) {
+        Node* node = last();
+        ::new (static_cast<void*>(node->at(node->hi))) T(std::forward<Args>(args)...);
+        node->hi++;
+    } else {
+        Node* node = new_node(0);
+        try {
+            ::new (static_cast<void*>(node->at(0))) T(std::forward<Args>(args)...);
+        } catch (...) {
+            recycle(node);
+            throw;
+        }
+        node->hi++;
+        link_after(sentinel.prev, node);
+    }
+    size_++;
+}
+
+template <typename T, size_t K>
+std::optional<T> UnrolledListDeque<T, K>::remove_front() {
+    if (empty())
+        return std::nullopt;
+
+    Node* node = first();
+    T* item = node->at(node->lo);
+    std::optional<T> val = std::move(*item);
+    std::destroy_at(item);
+    node->lo++;
+    size_--;
+
+    if (node->count() == 0) {
+        unlink(node);
+        recycle(node);
+    }
+
+    return val;
+}
+
+template <typename T, size_t K>
+std::optional<T> UnrolledListDeque<T, K>::remove_back() {
+    if (empty())
+        return std::nullopt;
+
+    Node* node = last();
+    T* item = node->at(node->hi - 1);
+    std::optional<T> val = std::move(*item);
+    std::destroy_at(item);
+    node->hi--;
+    size_--;
+
+    if (node->count() == 0) {
+        unlink(node);
+        recycle(node);
+    }
+
+    return val;
+}
+
+template <typename T, size_t K>
+bool UnrolledListDeque<T, K>::empty() {
+    return size_ == 0;
+}
+
+template <typename T, size_t K>
+size_t UnrolledListDeque<T, K>::size() {
+    return size_;
+}
+
+template <typename T, size_t K>
+T& UnrolledListDeque<T, K>::operator[](size_t idx) {
+    if (idx < size_ / 2) {
+        Node* node = first();
+        while (idx >= node->count()) {
+            idx -= node->count();
+            node = static_cast<Node*>(node->next);
+        }
+        return *node->at(node->lo + idx);
+    } else {
+        size_t ridx = size_ - 1 - idx;
+        Node* node = last();
+        while (ridx >= node->count()) {
+            ridx -= node->count();
+            node = static_cast<Node*>(node->prev);
+        }
+        return *node->at(node->hi - 1 - ridx);
+    }
+}
+
+template <typename T, size_t K>
+void UnrolledListDeque<T, K>::splice_back(UnrolledListDeque& other) {
+    if (&other == this || other.empty())
+        return;
+
+    Link* other_first = other.sentinel.next;
+    Link* other_last = other.sentinel.prev;
+
+    other_first->prev = sentinel.prev;
+    sentinel.prev->next = other_first;
+    other_last->next = &sentinel;
+    sentinel.prev = other_last;
+    size_ += other.size_;
+
+    other.sentinel.prev = other.sentinel.next = &other.sentinel;
+    other.size_ = 0;
+}
+
+template <typename T, size_t K>
+void UnrolledListDeque<T, K>::splice_front(UnrolledListDeque& other) {
+    if (&other == this || other.empty())
+        return;
+
+    Link* other_first = other.sentinel.next;
+    Link* other_last = other.sentinel.prev;
+
+    other_last->next = sentinel.next;
+    sentinel.next->prev = other_last;
+    other_first->prev = &sentinel;
+    sentinel.next = other_first;
+    size_ += other.size_;
+
+    other.sentinel.prev = other.sentinel.next = &other.sentinel;
+    other.size_ = 0;
+}
+
+#endif // _UNROLLED_DEQUE_H
@@ -0,0 +1,161 @@
+#ifndef _WORK_STEALING_DEQUE_H
+#define _WORK_STEALING_DEQUE_H
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+/* A Chase-Lev work-stealing deque (with the memory orderings from Lê et al.,
+ * "Correct and Efficient Work-Stealing for Weak Memory Models", PPoPP'13).
+ *
+ * The owner thread pushes and removes at the back, like a stack. Any other
+ * thread may steal from the front. `top` and `bottom` are never wrapped;
+ * the items live at [top, bottom) of a circular power-of-two array, indexed
+ * with a mask like ArrayDeque.
+ *
+ * When the array is full the owner copies the items to an array twice as
+ * large. A thief may still be reading the old one, so retired arrays are kept
+ * until the deque is destroyed (they add up to less than the live array).
+ *
+ * Items are read and written atomically, so T must be trivially copyable
+ * (typically a pointer to a task).
+ */
+template <typename T>
+class WorkStealingDeque {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "WorkStealingDeque items must be trivially copyable");
+
+public:
+    explicit WorkStealingDeque(size_t capacity = 64);
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    /* Owner only */
+    void push_back(const T&);
+    std::optional<T> remove_back();
+
+    /* Any thread. Returns std::nullopt if the deque is empty or another
+       thread won the race for the front item. */
+    std::optional<T> steal();
+
+    /* Approximate when other threads are running */
+    size_t size() const;
+    bool empty() const { return size() == 0; }
+    size_t capacity() const { return array.load(std::memory_order_relaxed)->capacity(); }
+
+private:
+    class CircularArray {
+    public:
+        explicit CircularArray(size_t capacity)
+            : mask(capacity - 1), items(std::make_unique<std::atomic<T>[]>(capacity)) {}
+
+        size_t capacity() const { return mask + 1; }
+
+        T get(int64_t i) const { return items[i & mask].load(std::memory_order_relaxed); }
+        void put(int64_t i, const T& t) { items[i & mask].store(t, std::memory_order_relaxed); }
+
+        std::unique_ptr<CircularArray> grow(int64_t top, int64_t bottom) const {
+            auto bigger = std::make_unique<CircularArray>(capacity() * 2);
+            for (int64_t i = top; i < bottom; i++)
+                bigger->put(i, get(i));
+            return bigger;
+        }
+
+    private:
+        size_t mask;
+        std::unique_ptr<std::atomic<T>[]> items;
+    };
+
+    alignas(64) std::atomic<int64_t> top{0};
+    alignas(64) std::atomic<int64_t> bottom{0};
+    std::atomic<CircularArray*> array;
+
+    /* Every array ever used, owned by the deque and only touched by the owner */
+    std::vector<std::unique_ptr<CircularArray>> arrays;
+};
+
+template <typename T>
+WorkStealingDeque<T>::WorkStealingDeque(size_t capacity) {
+    size_t c = 2;
+    while (c < capacity)
+        c *= 2;
+
+    arrays.emplace_back(std::make_unique<CircularArray>(c));
+    array.store(arrays.back().get(), std::memory_order_relaxed);
+}
+
+template <typename T>
+void WorkStealingDeque<T>::push_back(const T& item) {
+    int64_t b = bottom.load(std::memory_order_relaxed);
+    int64_t t = top.load(std::memory_order_acquire);
+    CircularArray* a = array.load(std::memory_order_relaxed);
+
+    if (b - t > static_cast<int64_t>(a->capacity()) - 1) {
+        arrays.emplace_back(a->grow(t, b));
+        a = arrays.back().get();
+        array.store(a, std::memory_order_release);
+    }
+
+    a->put(b, item);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom.store(b + 1, std::memory_order_relaxed);
+}
+
+template <typename T>
+std::optional<T> WorkStealingDeque<T>::remove_back() {
+    int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+    CircularArray* a = array.load(std::memory_order_relaxed);
+
+    /* Reserve the back item before looking at top */
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top.load(std::memory_order_relaxed);
+
+    if (t > b) {
+        /* Empty */
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+
+    std::optional<T> item = a->get(b);
+    if (t == b) {
+        /* The last item: race against the thieves for it */
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                         std::memory_order_relaxed))
+            item = std::nullopt;
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    return item;
+}
+
+template <typename T>
+std::optional<T> WorkStealingDeque<T>::steal() {
+    int64_t t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = bottom.load(std::memory_order_acquire);
+
+    if (t >= b)
+        return std::nullopt;
+
+    CircularArray* a = array.load(std::memory_order_acquire);
+    T item = a->get(t);
+    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                     std::memory_order_relaxed))
+        return std::nullopt;
+
+    return item;
+}
+
+template <typename T>
+size_t WorkStealingDeque<T>::size() const {
+    int64_t b = bottom.load(std::memory_order_relaxed);
+    int64_t t = top.load(std::memory_order_relaxed);
+    return b > t ? b - t : 0;
+}
+
+#endif // _WORK_STEALING_DEQUE_H
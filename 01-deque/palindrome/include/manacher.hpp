@@ -0,0 +1,180 @@
+#ifndef _MANACHER_H
+#define _MANACHER_H
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/* Manacher's algorithm: for every center of `s`, the radius of the longest
+ * palindrome around it, in O(n) overall.
+ *
+ * odd[i] is the number of odd palindromes centered on s[i], so the longest
+ * is s[i - odd[i] + 1, i + odd[i]). even[i] is the number of even palindromes
+ * centered between s[i - 1] and s[i], so the longest is s[i - even[i], i + even[i]).
+ *
+ * Each side keeps the rightmost palindrome found so far, [l, r); a center
+ * inside it starts from the radius of its mirror image, so every byte is
+ * compared O(1) times.
+ */
+inline void manacher(std::string_view s, std::vector<uint32_t>& odd, std::vector<uint32_t>& even) {
+    size_t n = s.size();
+    odd.assign(n, 0);
+    even.assign(n, 0);
+
+    for (size_t i = 0, l = 0, r = 0; i < n; i++) {
+        size_t k = i < r ? std::min<size_t>(odd[l + r - 1 - i], r - i) : 1;
+        while (i >= k && i + k < n && s[i - k] == s[i + k])
+            k++;
+        odd[i] = k;
+        if (i + k > r) {
+            l = i - k + 1;
+            r = i + k;
+        }
+    }
+
+    for (size_t i = 0, l = 0, r = 0; i < n; i++) {
+        size_t k = i < r ? std::min<size_t>(even[l + r - i], r - i) : 0;
+        while (i >= k + 1 && i + k < n && s[i - k - 1] == s[i + k])
+            k++;
+        even[i] = k;
+        if (i + k > r) {
+            l = i - k;
+            r = i + k;
+        }
+    }
+}
+
+/* Results of manacher_batch(), one entry per document, as parallel arrays.
+ *
+ * The longest palindromic substring of document d is
+ * [longest_start[d], longest_start[d] + longest_length[d]) (the leftmost one
+ * if there are several). Its maximal palindromes, the ones that cannot be
+ * extended around their center, are entries [maximal_offsets[d],
+ * maximal_offsets[d + 1]) of maximal_start/maximal_length, ordered by center.
+ * Offsets are 32 bits, so each document must be shorter than 4 GiB.
+ */
+struct ManacherBatchResult {
+    std::vector<uint32_t> longest_start;
+    std::vector<uint32_t> longest_length;
+
+    std::vector<size_t> maximal_offsets;
+    std::vector<uint32_t> maximal_start;
+    std::vector<uint32_t> maximal_length;
+
+    size_t size() const { return longest_start.size(); }
+    size_t maximal_count(size_t d) const { return maximal_offsets[d + 1] - maximal_offsets[d]; }
+};
+
+namespace manacher_detail {
+
+/* Maximal palindromes of documents [first, last), kept by one worker */
+struct Partial {
+    std::vector<uint32_t> counts;
+    std::vector<uint32_t> start;
+    std::vector<uint32_t> length;
+};
+
+inline void run(const std::vector<std::string_view>& docs, size_t first, size_t last,
+                size_t min_length, ManacherBatchResult& out, Partial& partial) {
+    std::vector<uint32_t> odd, even;
+
+    for (size_t d = first; d < last; d++) {
+        std::string_view s = docs[d];
+        manacher(s, odd, even);
+
+        uint32_t best_start = 0, best_length = 0;
+        size_t before = partial.start.size();
+        auto report = [&](uint32_t start, uint32_t length) {
+            if (length > best_length) {
+                best_start = start;
+                best_length = length;
+            }
+            if (length >= min_length && length > 0) {
+                partial.start.push_back(start);
+                partial.length.push_back(length);
+            }
+        };
+
+        for (uint32_t i = 0; i < s.size(); i++) {
+            if (even[i] > 0)
+                report(i - even[i], 2 * even[i]);
+            report(i - odd[i] + 1, 2 * odd[i] - 1);
+        }
+
+        out.longest_start[d] = best_start;
+        out.longest_length[d] = best_length;
+        partial.counts.push_back(static_cast<uint32_t>(partial.start.size() - before));
+    }
+}
+
+} // namespace manacher_detail
+
+/* Run Manacher's algorithm over every document of a batch on `threads`
+ * threads (0 for one per hardware thread). Maximal palindromes shorter than
+ * `min_length` are left out of the result; by default single characters are.
+ *
+ * Documents are split into contiguous runs of about the same number of
+ * bytes. Each thread writes the longest palindromes straight into the result
+ * and collects its maximal palindromes locally; those are concatenated in
+ * document order at the end.
+ */
+inline ManacherBatchResult manacher_batch(const std::vector<std::string_view>& docs,
+                                          size_t min_length = 2, unsigned threads = 0) {
+    size_t total = 0;
+    for (std::string_view s : docs) {
+        if (s.size() > std::numeric_limits<uint32_t>::max() / 2)
+            throw std::length_error("manacher_batch: document too long");
+        total += s.size();
+    }
+
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::min<size_t>(threads, std::max<size_t>(docs.size(), 1)));
+
+    ManacherBatchResult out;
+    out.longest_start.resize(docs.size());
+    out.longest_length.resize(docs.size());
+
+    /* Document d starts run t when the bytes before it reach t / threads of the total */
+    std::vector<size_t> bounds{0};
+    size_t seen = 0;
+    for (size_t d = 0; d < docs.size() && bounds.size() < threads; d++) {
+        seen += docs[d].size();
+        if (seen * threads >= total * bounds.size())
+            bounds.push_back(d + 1);
+    }
+    while (bounds.size() <= threads)
+        bounds.push_back(docs.size());
+
+    std::vector<manacher_detail::Partial> partials(threads);
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; t++)
+        workers.emplace_back(manacher_detail::run, std::cref(docs), bounds[t], bounds[t + 1],
+                             min_length, std::ref(out), std::ref(partials[t]));
+    manacher_detail::run(docs, bounds[0], bounds[1], min_length, out, partials[0]);
+    for (auto& w : workers)
+        w.join();
+
+    size_t maximal = 0;
+    for (auto& p : partials)
+        maximal += p.start.size();
+
+    out.maximal_offsets.reserve(docs.size() + 1);
+    out.maximal_offsets.push_back(0);
+    out.maximal_start.reserve(maximal);
+    out.maximal_length.reserve(maximal);
+    for (auto& p : partials) {
+        for (uint32_t count : p.counts)
+            out.maximal_offsets.push_back(out.maximal_offsets.back() + count);
+        out.maximal_start.insert(out.maximal_start.end(), p.start.begin(), p.start.end());
+        out.maximal_length.insert(out.maximal_length.end(), p.length.begin(), p.length.end());
+    }
+
+    return out;
+}
+
+#endif // _MANACHER_H
@@ -2,7 +2,7 @@
 
 #include "deque.hpp"
 
-template<typename Deque>
+template<DequeLike Deque>
 class Palindrome {
 public:
     bool is_palindrome(const std::string&);
@@ -12,7 +12,7 @@ private:
     Deque deque;
 };
 
-template<typename Deque>
+template<DequeLike Deque>
 bool Palindrome<Deque>::is_palindrome(const std::string& s1) {
     // TODO
     for(int i = 0; i < s1.size(); i++){
@@ -28,7 +28,7 @@ bool Palindrome<Deque>::is_palindrome(const std::string& s1) {
     return true;
 }
 
-template<typename Deque>
+template<DequeLike Deque>
 void Palindrome<Deque>::reset_deque() {
     while (!deque.empty())
         deque.remove_front();
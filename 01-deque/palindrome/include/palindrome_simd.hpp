@@ -0,0 +1,341 @@
+#ifndef _PALINDROME_SIMD_H
+#define _PALINDROME_SIMD_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <string_view>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/* How characters are compared by is_palindrome_simd(). */
+struct PalindromeOptions {
+    /* 'A'..'Z' compare equal to 'a'..'z' */
+    bool fold_case = false;
+    /* Only [A-Za-z0-9] take part; everything else is skipped */
+    bool skip_non_alnum = false;
+};
+
+/* The kernels behind is_palindrome_simd().
+ *
+ * The text is read in blocks of `block_size` bytes: 32 with AVX2, 16 with
+ * SSE2 (and in the scalar fallback). compact_block() folds the case of a
+ * block, classifies its bytes and packs the kept ones together in vector
+ * registers; mirrored blocks are compared by reversing the back block in a
+ * register and comparing it with the front block in one instruction.
+ */
+namespace palindrome_detail {
+
+#if defined(__AVX2__)
+constexpr size_t block_size = 32;
+#else
+constexpr size_t block_size = 16;
+#endif
+
+using block_mask = uint32_t;
+constexpr block_mask full_mask = block_size == 32 ? 0xffffffffu : 0xffffu;
+
+inline bool is_upper(unsigned char c) { return static_cast<unsigned>(c - 'A') < 26u; }
+
+inline bool is_alnum(unsigned char c) {
+    return static_cast<unsigned>(c - '0') < 10u || static_cast<unsigned>((c | 0x20) - 'a') < 26u;
+}
+
+inline char fold(char c, bool fold_case) {
+    return fold_case && is_upper(c) ? c | 0x20 : c;
+}
+
+#if defined(__AVX2__)
+
+using vec = __m256i;
+
+inline vec load(const char* p) { return _mm256_loadu_si256(reinterpret_cast<const vec*>(p)); }
+inline void store(char* p, vec v) { _mm256_storeu_si256(reinterpret_cast<vec*>(p), v); }
+inline vec splat(char c) { return _mm256_set1_epi8(c); }
+inline vec vor(vec a, vec b) { return _mm256_or_si256(a, b); }
+inline vec vand(vec a, vec b) { return _mm256_and_si256(a, b); }
+inline block_mask movemask(vec v) { return static_cast<block_mask>(_mm256_movemask_epi8(v)); }
+inline block_mask equal(vec a, vec b) { return movemask(_mm256_cmpeq_epi8(a, b)); }
+
+/* 0xff where lo <= x < lo + len. Shifting `lo` to -128 turns the unsigned
+   range check into one signed compare. */
+inline vec in_range(vec x, char lo, char len) {
+    vec t = _mm256_add_epi8(x, splat(static_cast<char>(-128 - lo)));
+    return _mm256_cmpgt_epi8(splat(static_cast<char>(-128 + len)), t);
+}
+
+inline vec reverse(vec v) {
+    const vec idx = _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                                     15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(v, idx), 0x4e);
+}
+
+#elif defined(__SSE2__)
+
+using vec = __m128i;
+
+inline vec load(const char* p) { return _mm_loadu_si128(reinterpret_cast<const vec*>(p)); }
+inline void store(char* p, vec v) { _mm_storeu_si128(reinterpret_cast<vec*>(p), v); }
+inline vec splat(char c) { return _mm_set1_epi8(c); }
+inline vec vor(vec a, vec b) { return _mm_or_si128(a, b); }
+inline vec vand(vec a, vec b) { return _mm_and_si128(a, b); }
+inline block_mask movemask(vec v) { return static_cast<block_mask>(_mm_movemask_epi8(v)); }
+inline block_mask equal(vec a, vec b) { return movemask(_mm_cmpeq_epi8(a, b)); }
+
+inline vec in_range(vec x, char lo, char len) {
+    vec t = _mm_add_epi8(x, splat(static_cast<char>(-128 - lo)));
+    return _mm_cmplt_epi8(t, splat(static_cast<char>(-128 + len)));
+}
+
+/* SSE2 has no byte shuffle: swap the bytes of each word, then reverse the
+   words. */
+inline vec reverse(vec v) {
+    v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+    v = _mm_shufflelo_epi16(v, 0x1b);
+    v = _mm_shufflehi_epi16(v, 0x1b);
+    return _mm_shuffle_epi32(v, 0x4e);
+}
+
+#endif
+
+#if defined(__AVX2__) || defined(__SSE2__)
+
+inline vec fold(vec x, bool fold_case) {
+    if (!fold_case)
+        return x;
+    return vor(x, vand(in_range(x, 'A', 26), splat(0x20)));
+}
+
+/* Bit i is set if x[i] is a letter or a digit */
+inline block_mask alnum_mask(vec x) {
+    vec letter = in_range(vor(x, splat(0x20)), 'a', 26);
+    vec digit = in_range(x, '0', 10);
+    return movemask(vor(letter, digit));
+}
+
+#endif
+
+/* Is front[i] == back[block_size - 1 - i] for every i? */
+inline bool mirrored_blocks_equal(const char* front, const char* back) {
+#if defined(__AVX2__) || defined(__SSE2__)
+    return equal(load(front), reverse(load(back))) == full_mask;
+#else
+    for (size_t i = 0; i < block_size; i++)
+        if (front[i] != back[block_size - 1 - i])
+            return false;
+    return true;
+#endif
+}
+
+/* Is fold(front[i]) == fold(back_end[-1 - i]) for every i < n? */
+inline bool mirrored_equal(const char* front, const char* back_end, size_t n, bool fold_case) {
+    size_t i = 0;
+#if defined(__AVX2__) || defined(__SSE2__)
+    for (; i + block_size <= n; i += block_size) {
+        vec f = fold(load(front + i), fold_case);
+        vec b = fold(load(back_end - i - block_size), fold_case);
+        if (equal(f, reverse(b)) != full_mask)
+            return false;
+    }
+#endif
+    for (; i < n; i++)
+        if (fold(front[i], fold_case) != fold(back_end[-1 - static_cast<std::ptrdiff_t>(i)], fold_case))
+            return false;
+    return true;
+}
+
+#if defined(__SSSE3__)
+
+/* For each 8-bit mask, the pshufb indices that gather the bytes whose bit
+   is set to the front (0x80, which zeroes a byte, for the rest), and how
+   many there are. */
+struct CompactTable {
+    uint64_t shuffle[256];
+    uint8_t count[256];
+};
+
+constexpr CompactTable make_compact_table() {
+    CompactTable t{};
+    for (unsigned m = 0; m < 256; m++) {
+        uint64_t idx = 0x8080808080808080ull;
+        unsigned n = 0;
+        for (unsigned i = 0; i < 8; i++) {
+            if (m & (1u << i)) {
+                idx &= ~(uint64_t{0xff} << (8 * n));
+                idx |= uint64_t{i} << (8 * n);
+                n++;
+            }
+        }
+        t.shuffle[m] = idx;
+        t.count[m] = static_cast<uint8_t>(n);
+    }
+    return t;
+}
+
+inline constexpr CompactTable compact_table = make_compact_table();
+
+/* Write the bytes of x whose bit is set in mask (16 bits) to out, packed,
+   and return how many there are. Each half is packed by one pshufb with
+   a table entry, so the store may write up to 16 bytes. */
+inline size_t compact16(__m128i x, uint32_t mask, char* out) {
+    unsigned lo = mask & 0xff, hi = (mask >> 8) & 0xff;
+    __m128i idx = _mm_set_epi64x(static_cast<long long>(compact_table.shuffle[hi]),
+                                 static_cast<long long>(compact_table.shuffle[lo]));
+    idx = _mm_add_epi8(idx, _mm_set_epi64x(0x0808080808080808ll, 0));
+    __m128i packed = _mm_shuffle_epi8(x, idx);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out), packed);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out + compact_table.count[lo]),
+                     _mm_unpackhi_epi64(packed, packed));
+    return compact_table.count[lo] + compact_table.count[hi];
+}
+
+#endif
+
+/* Write the kept bytes of the block at p to out, packed and case-folded if
+ * asked, and return how many there are. With `reversed`, the block is read
+ * from its last byte to its first. out must have room for block_size bytes
+ * past the kept ones.
+ *
+ * SSE2 has no byte shuffle, so without SSSE3 the kept bytes are packed by a
+ * branch-free scalar loop over the normalized block.
+ */
+inline size_t compact_block(const char* p, bool reversed, const PalindromeOptions& opts,
+                            char* out) {
+#if defined(__AVX2__) || defined(__SSE2__)
+    vec x = load(p);
+    if (reversed)
+        x = reverse(x);
+    vec folded = fold(x, opts.fold_case);
+    if (!opts.skip_non_alnum) {
+        store(out, folded);
+        return block_size;
+    }
+    block_mask mask = alnum_mask(x);
+#if defined(__AVX2__)
+    size_t n = compact16(_mm256_castsi256_si128(folded), mask & 0xffff, out);
+    return n + compact16(_mm256_extracti128_si256(folded, 1), mask >> 16, out + n);
+#elif defined(__SSSE3__)
+    return compact16(folded, mask, out);
+#else
+    char block[block_size];
+    store(block, folded);
+    size_t n = 0;
+    for (size_t i = 0; i < block_size; i++) {
+        out[n] = block[i];
+        n += (mask >> i) & 1;
+    }
+    return n;
+#endif
+#else
+    size_t n = 0;
+    for (size_t i = 0; i < block_size; i++) {
+        char c = p[reversed ? block_size - 1 - i : i];
+        out[n] = fold(c, opts.fold_case);
+        n += !opts.skip_non_alnum || is_alnum(c);
+    }
+    return n;
+#endif
+}
+
+/* Is a[i] == b[i] for every i < block_size? */
+inline bool blocks_equal(const char* a, const char* b) {
+#if defined(__AVX2__) || defined(__SSE2__)
+    return equal(load(a), load(b)) == full_mask;
+#else
+    return std::memcmp(a, b, block_size) == 0;
+#endif
+}
+
+/* Reads from memory. A `Source` hands out a pointer to the n bytes at
+   offset pos, so other sources can page a file in behind it. */
+struct MemorySource {
+    const char* text;
+
+    const char* data(size_t pos, size_t) { return text + pos; }
+};
+
+/* Compare the kept bytes of a text of `size` bytes from both ends until the
+ * two ends meet. `front` and `back` read the text from its two ends.
+ *
+ * Each end packs the kept bytes of its next block into a buffer, in reading
+ * order (backwards for the back end), and the two buffers are compared a
+ * whole block at a time in registers. An end only reads on while its buffer
+ * holds less than a block, so the buffers stay under two blocks. What is
+ * left when fewer than a block of unread bytes separates the ends is checked
+ * on its own: the rest of the front buffer, the kept bytes in between, and
+ * the rest of the back buffer, reversed, must read the same both ways.
+ */
+template <typename Source>
+bool mirrored_kept_equal(Source& front, Source& back, size_t size,
+                         const PalindromeOptions& opts) {
+    size_t i = 0;       /* first byte not yet read from the front */
+    size_t j = size;    /* one past the last byte not yet read from the back */
+    char fbuf[3 * block_size], bbuf[3 * block_size];
+    size_t flen = 0, blen = 0;
+
+    while (true) {
+        bool read = false;
+        if (flen < block_size && j - i >= block_size) {
+            flen += compact_block(front.data(i, block_size), false, opts, fbuf + flen);
+            i += block_size;
+            read = true;
+        }
+        if (blen < block_size && j - i >= block_size) {
+            blen += compact_block(back.data(j - block_size, block_size), true, opts, bbuf + blen);
+            j -= block_size;
+            read = true;
+        }
+
+        if (flen >= block_size && blen >= block_size) {
+            if (!blocks_equal(fbuf, bbuf))
+                return false;
+            /* Less than a block is left in each buffer */
+            flen -= block_size;
+            blen -= block_size;
+            std::memcpy(fbuf, fbuf + block_size, flen);
+            std::memcpy(bbuf, bbuf + block_size, blen);
+        } else if (!read) {
+            break;
+        }
+    }
+
+    char mid[5 * block_size];
+    size_t n = flen;
+    std::memcpy(mid, fbuf, flen);
+    if (j > i) {
+        const char* p = front.data(i, j - i);
+        for (size_t k = 0; k < j - i; k++) {
+            mid[n] = fold(p[k], opts.fold_case);
+            n += !opts.skip_non_alnum || is_alnum(p[k]);
+        }
+    }
+    std::reverse_copy(bbuf, bbuf + blen, mid + n);
+    n += blen;
+
+    return std::equal(mid, mid + n / 2, std::reverse_iterator<char*>(mid + n));
+}
+
+} // namespace palindrome_detail
+
+/* Is `s` a palindrome? Unlike Palindrome<Deque>, the text is compared in
+ * place, a vector block at a time from both ends, and nothing is copied.
+ */
+inline bool is_palindrome_simd(std::string_view s, const PalindromeOptions& opts = {}) {
+    using namespace palindrome_detail;
+
+    if (!opts.skip_non_alnum)
+        return mirrored_equal(s.data(), s.data() + s.size(), s.size() / 2, opts.fold_case);
+
+    MemorySource front{s.data()}, back{s.data()};
+    return mirrored_kept_equal(front, back, s.size(), opts);
+}
+
+#endif // _PALINDROME_SIMD_H
@@ -0,0 +1,121 @@
+#ifndef _PALINDROME_STREAM_H
+#define _PALINDROME_STREAM_H
+
+#include <cerrno>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "palindrome_simd.hpp"
+
+/* Palindrome checks over input that is never held in memory as a whole.
+ *
+ * The text is read through two windows of `window` bytes, one walking in
+ * from the front and one from the back, and compared with the kernels of
+ * palindrome_simd.hpp. Memory use is bounded by the two windows whatever
+ * the size of the input. These checks keep no state between calls, so
+ * there is nothing to reset.
+ */
+
+constexpr size_t palindrome_stream_window = 1 << 16;
+
+namespace palindrome_detail {
+
+/* A Source (see MemorySource) that pages the text in through a window.
+ *
+ * `read(pos, dst, n)` must copy the n bytes at offset pos to dst. The front
+ * window is refilled starting at the requested offset and the back window
+ * ending at it, so each end reads every byte once.
+ */
+template <typename Reader>
+class ChunkSource {
+public:
+    ChunkSource(Reader& read, size_t size, bool backward, size_t window)
+        : read(read), size(size), backward(backward),
+          window(std::max(window, block_size)), buf(std::make_unique<char[]>(this->window)) {}
+
+    const char* data(size_t pos, size_t n) {
+        if (pos < lo || pos + n > hi) {
+            if (backward) {
+                hi = pos + n;
+                lo = hi - std::min(window, hi);
+            } else {
+                lo = pos;
+                hi = lo + std::min(window, size - lo);
+            }
+            read(lo, buf.get(), hi - lo);
+        }
+        return buf.get() + (pos - lo);
+    }
+
+private:
+    Reader& read;
+    size_t size;
+    bool backward;
+    size_t window;
+    std::unique_ptr<char[]> buf;
+    size_t lo = 0;
+    size_t hi = 0;
+};
+
+} // namespace palindrome_detail
+
+/* Is the text of `size` bytes a palindrome? `front` and `back` read it
+ * from its two ends, as `read(pos, dst, n)`: copy the n bytes at offset pos
+ * to dst. They may be the same reader.
+ */
+template <typename FrontReader, typename BackReader>
+bool is_palindrome_stream(size_t size, FrontReader&& front, BackReader&& back,
+                          const PalindromeOptions& opts = {},
+                          size_t window = palindrome_stream_window) {
+    using namespace palindrome_detail;
+
+    ChunkSource<std::remove_reference_t<FrontReader>> f(front, size, false, window);
+    ChunkSource<std::remove_reference_t<BackReader>> b(back, size, true, window);
+    return mirrored_kept_equal(f, b, size, opts);
+}
+
+/* Is the file at `path` a palindrome? Both ends are read with pread(), so
+ * at most two windows of the file are in memory at a time. Throws
+ * std::system_error if the file cannot be read.
+ */
+inline bool is_palindrome_file(const std::string& path, const PalindromeOptions& opts = {},
+                               size_t window = palindrome_stream_window) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::system_error(errno, std::generic_category(), path);
+
+    struct Closer {
+        int fd;
+        ~Closer() { ::close(fd); }
+    } closer{fd};
+
+    struct stat st;
+    if (::fstat(fd, &st) < 0)
+        throw std::system_error(errno, std::generic_category(), path);
+
+    auto read = [&](size_t pos, char* dst, size_t n) {
+        while (n > 0) {
+            ssize_t got = ::pread(fd, dst, n, static_cast<off_t>(pos));
+            if (got < 0 && errno == EINTR)
+                continue;
+            if (got < 0)
+                throw std::system_error(errno, std::generic_category(), path);
+            if (got == 0)
+                throw std::runtime_error(path + ": file shrank while being read");
+            dst += got;
+            pos += got;
+            n -= got;
+        }
+    };
+
+    return is_palindrome_stream(static_cast<size_t>(st.st_size), read, read, opts, window);
+}
+
+#endif // _PALINDROME_STREAM_H
@@ -1,6 +1,12 @@
 #include <vector>
+#include <algorithm>
+#include <numeric>
+#include <set>
+#include <stdexcept>
 
 #include "deque.hpp"
+#include "block_deque.hpp"
+#include "unrolled_deque.hpp"
 
 #define CATCH_CONFIG_MAIN
 #include <catch2/catch.hpp>
@@ -50,6 +56,58 @@ TEST_CASE("Push with Resize", "[ArrayDeque]") {
     }
 }
 
+TEST_CASE("Shrink with hysteresis", "[ArrayDeque]") {
+    ArrayDeque<int> ad;
+    for(int i = 0 ; i < 4000 ; ++i) {
+        ad.push_back(i);
+    }
+    REQUIRE(ad.capacity() == 4096);
+
+    /* Halve only once the deque is less than a quarter full */
+    while(ad.size() > 1024) {
+        ad.remove_front();
+    }
+    REQUIRE(ad.capacity() == 4096);
+    ad.remove_front();
+    REQUIRE(ad.capacity() == 2048);
+
+    /* Hovering around the threshold does not resize back and forth */
+    for(int i = 0 ; i < 100 ; ++i) {
+        ad.push_back(i);
+        ad.remove_back();
+        REQUIRE(ad.capacity() == 2048);
+    }
+
+    for(int i = 3999 ; i >= 2977 ; --i) {
+        REQUIRE(ad.remove_back() == i);
+    }
+    REQUIRE(ad.empty());
+    REQUIRE(ad.capacity() == 64);
+}
+
+TEST_CASE("Reserve and shrink to fit", "[ArrayDeque]") {
+    ArrayDeque<int> ad;
+    ad.reserve(1000);
+    REQUIRE(ad.capacity() == 1024);
+
+    for(int i = 0 ; i < 1000 ; ++i) {
+        ad.push_back(i);
+    }
+    REQUIRE(ad.capacity() == 1024);
+
+    /* The reservation keeps the buffer from shrinking */
+    for(int i = 0 ; i < 990 ; ++i) {
+        ad.remove_front();
+    }
+    REQUIRE(ad.capacity() == 1024);
+
+    ad.shrink_to_fit();
+    REQUIRE(ad.capacity() == 64);
+    for(int i = 0 ; i < 10 ; ++i) {
+        REQUIRE(ad[i] == 990 + i);
+    }
+}
+
 TEST_CASE("Random Push test", "[ArrayDeque]") {
     std::random_device rd;
     std::mt19937 gen(rd());
@@ -163,6 +221,408 @@ TEST_CASE("Index operation", "[ArrayDeque]") {
     //}
 }
 
+TEST_CASE("Iterators", "[ArrayDeque]") {
+    ArrayDeque<int> ad;
+    std::deque<int> deq;
+
+    /* Make the items wrap around the end of the buffer. */
+    for(int i = 0 ; i < 100 ; ++i) {
+        ad.push_front(i * 7919 % 1000);
+        deq.push_front(i * 7919 % 1000);
+        ad.push_back(i * 104729 % 1000);
+        deq.push_back(i * 104729 % 1000);
+    }
+
+    REQUIRE(ad.end() - ad.begin() == 200);
+    REQUIRE(std::equal(ad.begin(), ad.end(), deq.begin(), deq.end()));
+    REQUIRE(std::accumulate(ad.begin(), ad.end(), 0) ==
+            std::accumulate(deq.begin(), deq.end(), 0));
+
+    std::sort(ad.begin(), ad.end());
+    std::sort(deq.begin(), deq.end());
+    for(int i = 0 ; i < 200 ; ++i) {
+        REQUIRE(ad[i] == deq[i]);
+    }
+
+    const ArrayDeque<int>& cad = ad;
+    ArrayDeque<int>::const_iterator it = ad.begin();
+    REQUIRE(it == cad.begin());
+    REQUIRE(*(cad.end() - 1) == deq.back());
+    REQUIRE(it[5] == deq[5]);
+}
+
+TEST_CASE("Span views and bulk operations", "[ArrayDeque]") {
+    ArrayDeque<int> ad;
+    std::vector<int> xs(1000);
+    std::iota(xs.begin(), xs.end(), 0);
+
+    /* Move the front close to the end of the buffer so the items wrap. */
+    for(int i = 0 ; i < 50 ; ++i) {
+        ad.push_back(-1);
+        ad.remove_front();
+    }
+
+    ad.push_back_range(xs.begin(), xs.begin() + 40);
+    REQUIRE(ad.size() == 40);
+    REQUIRE(ad.as_array_one().size() == 14);
+    REQUIRE(ad.as_array_two().size() == 26);
+    REQUIRE(ad.as_array_one()[0] == 0);
+    REQUIRE(ad.as_array_two()[0] == 14);
+
+    ad.push_back_range(xs.begin() + 40, xs.end());
+    REQUIRE(ad.size() == 1000);
+    REQUIRE(ad.capacity() == 1024);
+    REQUIRE(std::equal(ad.begin(), ad.end(), xs.begin(), xs.end()));
+
+    std::vector<int> ys(600);
+    REQUIRE(ad.remove_front_n(600, ys.data()) == ys.data() + 600);
+    REQUIRE(std::equal(ys.begin(), ys.end(), xs.begin()));
+    REQUIRE(ad.size() == 400);
+    REQUIRE(ad[0] == 600);
+
+    std::vector<int> zs;
+    ad.remove_front_n(1000, std::back_inserter(zs));
+    REQUIRE(zs.size() == 400);
+    REQUIRE(zs.back() == 999);
+    REQUIRE(ad.empty());
+    REQUIRE(ad.as_array_one().empty());
+    REQUIRE(ad.as_array_two().empty());
+}
+
+TEST_CASE("Random push and remove", "[BlockDeque]") {
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<int> dis(0,3);
+
+    BlockDeque<int> bd;
+    std::deque<int> deq;
+
+    for(int i = 0 ; i < 100000 ; ++i) {
+        switch(dis(gen)) {
+        case 0:
+            bd.push_front(i);
+            deq.emplace_front(i);
+            break;
+        case 1:
+            bd.push_back(i);
+            deq.emplace_back(i);
+            break;
+        case 2:
+            if (deq.empty()) {
+                REQUIRE(bd.remove_front() == std::nullopt);
+            } else {
+                REQUIRE(bd.remove_front() == deq.front());
+                deq.pop_front();
+            }
+            break;
+        default:
+            if (deq.empty()) {
+                REQUIRE(bd.remove_back() == std::nullopt);
+            } else {
+                REQUIRE(bd.remove_back() == deq.back());
+                deq.pop_back();
+            }
+        }
+    }
+
+    REQUIRE(bd.size() == deq.size());
+    for(size_t i = 0 ; i < deq.size() ; ++i) {
+        REQUIRE(bd[i] == deq[i]);
+    }
+}
+
+TEST_CASE("Queue traffic drifting across blocks", "[BlockDeque]") {
+    BlockDeque<int, 4> bd;
+
+    for(int i = 0 ; i < 10 ; ++i) {
+        bd.push_back(i);
+    }
+
+    /* The live window keeps moving to the right; the map should recenter
+       instead of growing without bound. */
+    for(int i = 10 ; i < 100000 ; ++i) {
+        bd.push_back(i);
+        REQUIRE(bd.remove_front() == i - 10);
+    }
+
+    REQUIRE(bd.size() == 10);
+    for(int i = 0 ; i < 10 ; ++i) {
+        REQUIRE(bd[i] == 99990 + i);
+    }
+}
+
+template <typename Deque>
+void check_move_and_emplace() {
+    Deque deque;
+    std::string long_string(100, 'x');
+
+    deque.push_back(std::move(long_string));
+    deque.emplace_back(3, 'y');
+    deque.emplace_front("front");
+
+    REQUIRE(deque.size() == 3);
+    REQUIRE(deque[0] == "front");
+    REQUIRE(deque[1] == std::string(100, 'x'));
+    REQUIRE(deque[2] == "yyy");
+
+    REQUIRE(deque.remove_back() == "yyy");
+    REQUIRE(deque.remove_front() == "front");
+    REQUIRE(deque.remove_front() == std::string(100, 'x'));
+    REQUIRE(deque.empty());
+}
+
+TEST_CASE("Move and emplace", "[deque]") {
+    check_move_and_emplace<ArrayDeque<std::string>>();
+    check_move_and_emplace<ListDeque<std::string>>();
+    check_move_and_emplace<BlockDeque<std::string>>();
+    check_move_and_emplace<UnrolledListDeque<std::string>>();
+}
+
+/* Not default constructible; counts the instances that are alive. */
+struct Tracked {
+    static inline int alive = 0;
+    int v;
+
+    explicit Tracked(int v) : v(v) { alive++; }
+    Tracked(const Tracked& o) : v(o.v) { alive++; }
+    Tracked(Tracked&& o) noexcept : v(o.v) { alive++; }
+    Tracked& operator=(const Tracked&) = default;
+    ~Tracked() { alive--; }
+};
+
+template <typename Deque>
+void check_only_live_items_constructed() {
+    Tracked::alive = 0;
+    {
+        Deque deque;
+        REQUIRE(Tracked::alive == 0);
+
+        for (int i = 0; i < 1000; i++)
+            deque.emplace_back(i);
+        REQUIRE(Tracked::alive == 1000);
+
+        for (int i = 0; i < 400; i++) {
+            REQUIRE(deque.remove_front()->v == i);
+            REQUIRE(deque.remove_back()->v == 999 - i);
+        }
+        REQUIRE(Tracked::alive == 200);
+        REQUIRE(deque[0].v == 400);
+    }
+    REQUIRE(Tracked::alive == 0);
+}
+
+TEST_CASE("Raw storage", "[deque]") {
+    check_only_live_items_constructed<ArrayDeque<Tracked>>();
+    check_only_live_items_constructed<BlockDeque<Tracked>>();
+    check_only_live_items_constructed<UnrolledListDeque<Tracked>>();
+}
+
+/* Its move may throw, so a resize copies it; the copy throws once
+   `copies_left` reaches zero. The addresses of the live instances are kept,
+   so that destroying one twice, or never, shows. */
+struct ThrowingCopy {
+    static inline std::set<const ThrowingCopy*> alive;
+    static inline int bad_destroys = 0;
+    static inline int copies_left = -1;
+    int v;
+
+    explicit ThrowingCopy(int v) : v(v) { alive.insert(this); }
+    ThrowingCopy(const ThrowingCopy& o) : v(o.v) {
+        if (copies_left == 0)
+            throw std::runtime_error("copy");
+        copies_left--;
+        alive.insert(this);
+    }
+    ThrowingCopy(ThrowingCopy&& o) : v(o.v) { alive.insert(this); }
+    ~ThrowingCopy() { bad_destroys += alive.erase(this) == 0; }
+};
+
+TEST_CASE("ArrayDeque resize leaves the deque intact when a copy throws", "[deque]") {
+    ThrowingCopy::alive.clear();
+    ThrowingCopy::bad_destroys = 0;
+    {
+        ArrayDeque<ThrowingCopy> deque;
+        int n = 0;
+
+        /* Push until a push needs a resize; its copies then throw */
+        size_t capacity = deque.capacity();
+        ThrowingCopy::copies_left = 10;
+        while (true) {
+            try {
+                deque.emplace_back(n);
+            } catch (const std::runtime_error&) {
+                break;
+            }
+            n++;
+        }
+
+        REQUIRE(deque.capacity() == capacity);
+        REQUIRE(deque.size() == static_cast<size_t>(n));
+        REQUIRE(ThrowingCopy::alive.size() == static_cast<size_t>(n));
+        for (int i = 0; i < n; i++) {
+            REQUIRE(ThrowingCopy::alive.count(&deque[i]) == 1);
+            REQUIRE(deque[i].v == i);
+        }
+
+        ThrowingCopy::copies_left = -1;
+        deque.emplace_back(n);
+        REQUIRE(deque.capacity() > capacity);
+        REQUIRE(ThrowingCopy::alive.size() == static_cast<size_t>(n + 1));
+        REQUIRE(deque.remove_front()->v == 0);
+    }
+    REQUIRE(ThrowingCopy::alive.empty());
+    REQUIRE(ThrowingCopy::bad_destroys == 0);
+}
+
+template <typename Deque>
+void check_against_std_deque() {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dis(0,3);
+
+    Deque deque;
+    std::deque<int> deq;
+
+    for(int i = 0 ; i < 20000 ; ++i) {
+        switch(dis(gen)) {
+        case 0:
+            deque.push_front(i);
+            deq.push_front(i);
+            break;
+        case 1:
+            deque.push_back(i);
+            deq.push_back(i);
+            break;
+        case 2:
+            REQUIRE(deque.remove_front() == (deq.empty() ? std::nullopt : std::optional<int>(deq.front())));
+            if (!deq.empty()) deq.pop_front();
+            break;
+        default:
+            REQUIRE(deque.remove_back() == (deq.empty() ? std::nullopt : std::optional<int>(deq.back())));
+            if (!deq.empty()) deq.pop_back();
+        }
+    }
+
+    REQUIRE(deque.size() == deq.size());
+    for(size_t i = 0 ; i < deq.size() ; i += 97) {
+        REQUIRE(deque[i] == deq[i]);
+    }
+}
+
+TEST_CASE("Node allocators", "[deque]") {
+    check_against_std_deque<ListDeque<int>>();
+    check_against_std_deque<ListDeque<int, HeapNodeAllocator<ListNode<int>>>>();
+    check_against_std_deque<ListDeque<int, PooledNodeAllocator<ListNode<int>, 3>>>();
+}
+
+TEST_CASE("Unrolled list", "[UnrolledListDeque]") {
+    check_against_std_deque<UnrolledListDeque<int>>();
+    check_against_std_deque<UnrolledListDeque<int, 3>>();
+
+    UnrolledListDeque<int, 4> xs;
+    for (int i = 0; i < 1000; i++)
+        xs.push_back(i);
+    for (int i = 1; i <= 1000; i++)
+        xs.push_front(-i);
+
+    for (int i = 0; i < 2000; i++)
+        REQUIRE(xs[i] == i - 1000);
+}
+
+TEST_CASE("Unrolled list splice", "[UnrolledListDeque]") {
+    UnrolledListDeque<int, 4> xs, ys, zs;
+    for (int i = 0; i < 10; i++) {
+        xs.push_back(i);
+        ys.push_back(10 + i);
+        zs.push_back(-10 + i);
+    }
+
+    xs.splice_back(ys);
+    xs.splice_front(zs);
+    REQUIRE(ys.empty());
+    REQUIRE(zs.empty());
+    REQUIRE(xs.size() == 30);
+
+    for (int i = 0; i < 30; i++)
+        REQUIRE(xs[i] == i - 10);
+
+    /* Both ends still work after splicing partly filled nodes together */
+    xs.push_front(-11);
+    xs.push_back(20);
+    REQUIRE(xs.remove_front() == -11);
+    REQUIRE(xs.remove_back() == 20);
+
+    ys.push_back(42);
+    REQUIRE(ys.remove_front() == 42);
+}
+
+static_assert(DequeLike<ArrayDeque<int>>);
+static_assert(DequeLike<ListDeque<int>>);
+static_assert(DequeLike<BlockDeque<int>>);
+static_assert(DequeLike<UnrolledListDeque<int>>);
+static_assert(!DequeLike<std::deque<int>>);
+
+/* No vptr: the virtual interface is only there through DequeAdapter */
+static_assert(!std::is_polymorphic_v<ArrayDeque<int>>);
+static_assert(!std::is_polymorphic_v<ListDeque<int>>);
+static_assert(!std::is_polymorphic_v<BlockDeque<int>>);
+static_assert(!std::is_polymorphic_v<UnrolledListDeque<int>>);
+
+/* A deque that is not a Deque<T> */
+struct StdDeque {
+    using value_type = int;
+    std::deque<int> xs;
+
+    void push_front(const int& x) { xs.push_front(x); }
+    void push_back(const int& x) { xs.push_back(x); }
+    std::optional<int> remove_front() {
+        if (xs.empty()) return std::nullopt;
+        int x = xs.front();
+        xs.pop_front();
+        return x;
+    }
+    std::optional<int> remove_back() {
+        if (xs.empty()) return std::nullopt;
+        int x = xs.back();
+        xs.pop_back();
+        return x;
+    }
+    bool empty() { return xs.empty(); }
+    size_t size() { return xs.size(); }
+    int& operator[](size_t i) { return xs[i]; }
+};
+
+TEST_CASE("Deque adapter", "[deque]") {
+    DequeAdapter<StdDeque> adapter;
+    Deque<int>& deque = adapter;
+
+    deque.push_back(1);
+    deque.push_front(0);
+    deque.push_back(2);
+
+    REQUIRE(deque.size() == 3);
+    REQUIRE(deque[1] == 1);
+    REQUIRE(adapter.get().xs.front() == 0);
+    REQUIRE(deque.remove_back() == 2);
+    REQUIRE(deque.remove_front() == 0);
+
+    /* The backends are picked at run time through the same adapter */
+    std::vector<std::unique_ptr<Deque<int>>> backends;
+    backends.push_back(std::make_unique<DequeAdapter<ArrayDeque<int>>>());
+    backends.push_back(std::make_unique<DequeAdapter<ListDeque<int>>>());
+    backends.push_back(std::make_unique<DequeAdapter<BlockDeque<int>>>());
+    backends.push_back(std::make_unique<DequeAdapter<UnrolledListDeque<int>>>());
+
+    for (auto& d : backends) {
+        for (int i = 0; i < 100; i++)
+            d->push_back(i);
+        d->push_front(-1);
+        REQUIRE(d->size() == 101);
+        REQUIRE((*d)[1] == 0);
+        REQUIRE(d->remove_back() == 99);
+        REQUIRE(d->remove_front() == -1);
+    }
+}
+
 TEST_CASE("It works", "[deque]") {
     REQUIRE(2 + 2 == 4);
 }
@@ -1,4 +1,19 @@
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <system_error>
+
+#include <unistd.h>
+
+#include "manacher.hpp"
 #include "palindrome.hpp"
+#include "palindrome_simd.hpp"
+#include "palindrome_stream.hpp"
 
 #define CATCH_CONFIG_MAIN
 #include <catch2/catch.hpp>
@@ -26,3 +41,203 @@ TEST_CASE("Is palindrome? ListDeque", "[palindrome]") {
 
     REQUIRE(!p.is_palindrome(s));
 }
+
+static bool naive_palindrome(const std::string& s, const PalindromeOptions& opts) {
+    std::string kept;
+    for (char c : s) {
+        if (opts.skip_non_alnum && !std::isalnum(static_cast<unsigned char>(c)))
+            continue;
+        kept += opts.fold_case ? std::tolower(static_cast<unsigned char>(c)) : c;
+    }
+    return std::equal(kept.begin(), kept.end(), kept.rbegin());
+}
+
+TEST_CASE("Is palindrome? SIMD", "[palindrome]") {
+    REQUIRE(is_palindrome_simd(""));
+    REQUIRE(is_palindrome_simd("able was I ere I saw elba"));
+    REQUIRE(!is_palindrome_simd("able was I ere I saw elba."));
+
+    std::string s{"A man, a plan, a canal: Panama!"};
+    REQUIRE(!is_palindrome_simd(s));
+    REQUIRE(!is_palindrome_simd(s, {true, false}));
+    REQUIRE(!is_palindrome_simd(s, {false, true}));
+    REQUIRE(is_palindrome_simd(s, {true, true}));
+}
+
+TEST_CASE("SIMD palindrome agrees with a naive check", "[palindrome]") {
+    std::mt19937 gen(12);
+    const std::string alphabet = "aAbB1 ,.";
+
+    for (size_t len = 0; len < 300; len++) {
+        for (int round = 0; round < 4; round++) {
+            std::string half;
+            for (size_t i = 0; i < len / 2; i++)
+                half += alphabet[gen() % alphabet.size()];
+
+            /* A mirrored string with some case and punctuation noise */
+            std::string s = half;
+            if (len % 2)
+                s += alphabet[gen() % alphabet.size()];
+            for (auto it = half.rbegin(); it != half.rend(); ++it) {
+                char c = *it;
+                if (round & 1 && std::isalpha(static_cast<unsigned char>(c)))
+                    c ^= 0x20;
+                s += c;
+            }
+            if (round & 2 && !s.empty()) {
+                size_t pos = gen() % s.size();
+                s.insert(pos, 1, gen() % 2 ? '!' : 'x');
+            }
+
+            for (bool fold : {false, true}) {
+                for (bool skip : {false, true}) {
+                    PalindromeOptions opts{fold, skip};
+                    REQUIRE(is_palindrome_simd(s, opts) == naive_palindrome(s, opts));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("SIMD palindrome with long skipped runs", "[palindrome]") {
+    std::string half;
+    for (int i = 0; i < 300; i++)
+        half += "Ab3"[i % 3];
+    std::string mirror(half.rbegin(), half.rend());
+
+    /* All the skipped bytes at one end, so that one end runs many blocks
+       ahead of the other */
+    for (size_t run : {0, 1, 31, 32, 33, 500}) {
+        std::string punct(run, ',');
+        for (const std::string& s : {half + punct + mirror, punct + half + mirror,
+                                     half + mirror + punct, half + "x" + punct + mirror}) {
+            REQUIRE(is_palindrome_simd(s, {false, true}));
+
+            std::string broken = s;
+            broken[broken.find('b')] = 'c';
+            REQUIRE(!is_palindrome_simd(broken, {false, true}));
+            REQUIRE(naive_palindrome(broken, {false, true}) == false);
+        }
+    }
+}
+
+TEST_CASE("Streaming palindrome over chunk readers", "[palindrome]") {
+    std::string s{"A man, a plan, a canal: Panama!"};
+    for (int i = 0; i < 8; i++)
+        s = s + " -- " + std::string(s.rbegin(), s.rend());
+
+    size_t reads = 0;
+    auto read = [&](size_t pos, char* dst, size_t n) {
+        std::memcpy(dst, s.data() + pos, n);
+        reads++;
+    };
+
+    for (size_t window : {1, 16, 100, 4096}) {
+        for (bool fold : {false, true}) {
+            for (bool skip : {false, true}) {
+                PalindromeOptions opts{fold, skip};
+                REQUIRE(is_palindrome_stream(s.size(), read, read, opts, window) ==
+                        is_palindrome_simd(s, opts));
+            }
+        }
+    }
+
+    /* Breaking the symmetry in the middle is still found */
+    s[s.size() / 2 - 3] = 'z';
+    REQUIRE(!is_palindrome_stream(s.size(), read, read, {true, true}, 64));
+    REQUIRE(reads > 0);
+}
+
+/* A fresh file in the temporary directory, removed when it goes out of scope */
+struct TempFile {
+    std::string path;
+
+    TempFile() {
+        path = (std::filesystem::temp_directory_path() / "palindrome_stream_XXXXXX").string();
+        int fd = mkstemp(path.data());
+        if (fd < 0)
+            throw std::system_error(errno, std::generic_category(), "mkstemp");
+        close(fd);
+    }
+
+    ~TempFile() { std::remove(path.c_str()); }
+};
+
+TEST_CASE("Streaming palindrome over a file", "[palindrome]") {
+    TempFile tmp;
+    const std::string& path = tmp.path;
+    std::string half;
+    for (int i = 0; i < 100000; i++)
+        half += static_cast<char>('a' + i % 26);
+
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << half << "Q" << std::string(half.rbegin(), half.rend());
+    }
+    REQUIRE(is_palindrome_file(path));
+
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << half << "Q" << std::string(half.rbegin(), half.rend()) << "x";
+    }
+    REQUIRE(!is_palindrome_file(path));
+
+    std::remove(path.c_str());
+    REQUIRE_THROWS_AS(is_palindrome_file(path), std::system_error);
+}
+
+TEST_CASE("Manacher batch agrees with brute force", "[palindrome]") {
+    std::mt19937 gen(14);
+    std::vector<std::string> texts{"", "a", "abba", "abacaba", "xabbay", "forgeeksskeegfor"};
+    for (int i = 0; i < 200; i++) {
+        std::string s;
+        size_t len = gen() % 60;
+        for (size_t j = 0; j < len; j++)
+            s += "ab"[gen() % 2];
+        texts.push_back(s);
+    }
+    std::vector<std::string_view> docs(texts.begin(), texts.end());
+
+    for (unsigned threads : {1u, 3u}) {
+        ManacherBatchResult r = manacher_batch(docs, 2, threads);
+        REQUIRE(r.size() == docs.size());
+        REQUIRE(r.maximal_offsets.size() == docs.size() + 1);
+
+        for (size_t d = 0; d < docs.size(); d++) {
+            std::string_view s = docs[d];
+            auto is_pal = [&](size_t start, size_t len) {
+                return std::equal(s.begin() + start, s.begin() + start + len,
+                                  s.rbegin() + (s.size() - start - len));
+            };
+
+            /* Longest, leftmost */
+            size_t best = 0, best_start = 0;
+            for (size_t i = 0; i < s.size(); i++)
+                for (size_t len = best + 1; i + len <= s.size(); len++)
+                    if (is_pal(i, len) && len > best) {
+                        best = len;
+                        best_start = i;
+                    }
+            REQUIRE(r.longest_length[d] == best);
+            REQUIRE(r.longest_start[d] == best_start);
+
+            /* Maximal: palindromes of length >= 2 that cannot grow around their center */
+            std::vector<std::pair<uint32_t, uint32_t>> expected;
+            for (size_t c = 1; c < 2 * s.size(); c++) {
+                /* Center c covers s[(c - len) / 2, (c + len) / 2) */
+                size_t len = c % 2;
+                while ((c - len) / 2 > 0 && (c + len) / 2 < s.size() &&
+                       s[(c - len) / 2 - 1] == s[(c + len) / 2])
+                    len += 2;
+                if (len >= 2)
+                    expected.emplace_back((c - len) / 2, len);
+            }
+
+            REQUIRE(r.maximal_count(d) == expected.size());
+            for (size_t k = 0; k < expected.size(); k++) {
+                REQUIRE(r.maximal_start[r.maximal_offsets[d] + k] == expected[k].first);
+                REQUIRE(r.maximal_length[r.maximal_offsets[d] + k] == expected[k].second);
+            }
+        }
+    }
+}
@@ -0,0 +1,112 @@
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "ring_deque.hpp"
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+template <typename Ring>
+void check_single_thread() {
+    Ring ring(100);
+    REQUIRE(ring.capacity() == 128);
+    REQUIRE(ring.empty());
+    REQUIRE(ring.remove_front() == std::nullopt);
+
+    /* Go around the ring a few times */
+    for (int lap = 0; lap < 3; lap++) {
+        for (int i = 0; i < 128; i++)
+            REQUIRE(ring.push_back(i));
+
+        REQUIRE(!ring.push_back(128));
+        REQUIRE(ring.size() == 128);
+
+        for (int i = 0; i < 128; i++)
+            REQUIRE(ring.remove_front() == i);
+
+        REQUIRE(ring.remove_front() == std::nullopt);
+    }
+}
+
+TEST_CASE("SPSC single thread", "[SPSCRingDeque]") {
+    check_single_thread<SPSCRingDeque<int>>();
+}
+
+TEST_CASE("MPMC single thread", "[MPMCRingDeque]") {
+    check_single_thread<MPMCRingDeque<int>>();
+}
+
+TEST_CASE("Items are destroyed", "[MPMCRingDeque]") {
+    auto item = std::make_shared<int>(42);
+    {
+        MPMCRingDeque<std::shared_ptr<int>> ring(8);
+        ring.push_back(item);
+        ring.push_back(item);
+        REQUIRE(item.use_count() == 3);
+        ring.remove_front();
+        REQUIRE(item.use_count() == 2);
+    }
+    REQUIRE(item.use_count() == 1);
+}
+
+TEST_CASE("One producer, one consumer", "[SPSCRingDeque]") {
+    SPSCRingDeque<int> ring(64);
+    const int N = 1'000'000;
+
+    std::thread producer([&] {
+        for (int i = 0; i < N; i++)
+            while (!ring.push_back(i))
+                std::this_thread::yield();
+    });
+
+    /* Items must come out in order */
+    bool in_order = true;
+    for (int i = 0; i < N; i++) {
+        std::optional<int> x;
+        while (!(x = ring.remove_front()))
+            std::this_thread::yield();
+        in_order &= (*x == i);
+    }
+
+    producer.join();
+    REQUIRE(in_order);
+    REQUIRE(ring.empty());
+}
+
+TEST_CASE("Many producers, many consumers", "[MPMCRingDeque]") {
+    MPMCRingDeque<long> ring(64);
+    const int P = 4, C = 4, N = 200'000;
+
+    std::vector<std::thread> threads;
+    std::vector<long> sums(C, 0);
+    std::atomic<int> consumed{0};
+
+    for (int p = 0; p < P; p++) {
+        threads.emplace_back([&, p] {
+            for (long i = 0; i < N; i++)
+                while (!ring.push_back(p * N + i))
+                    std::this_thread::yield();
+        });
+    }
+
+    for (int c = 0; c < C; c++) {
+        threads.emplace_back([&, c] {
+            while (consumed.load() < P * N) {
+                if (auto x = ring.remove_front()) {
+                    sums[c] += *x;
+                    consumed++;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (auto& t : threads)
+        t.join();
+
+    long total = P * N;
+    REQUIRE(std::accumulate(sums.begin(), sums.end(), 0L) == total * (total - 1) / 2);
+    REQUIRE(ring.empty());
+}
@@ -0,0 +1,73 @@
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "work_stealing_deque.hpp"
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+TEST_CASE("Owner end is LIFO, thief end is FIFO", "[WorkStealingDeque]") {
+    WorkStealingDeque<int> deque(4);
+
+    for (int i = 0; i < 100; i++)
+        deque.push_back(i);
+
+    REQUIRE(deque.size() == 100);
+    REQUIRE(deque.capacity() == 128);
+
+    REQUIRE(deque.remove_back() == 99);
+    REQUIRE(deque.steal() == 0);
+    REQUIRE(deque.steal() == 1);
+    REQUIRE(deque.remove_back() == 98);
+
+    while (deque.remove_back())
+        ;
+
+    REQUIRE(deque.empty());
+    REQUIRE(deque.steal() == std::nullopt);
+    REQUIRE(deque.remove_back() == std::nullopt);
+}
+
+TEST_CASE("Each item is taken exactly once", "[WorkStealingDeque]") {
+    WorkStealingDeque<int> deque(8);
+    const int N = 200'000, THIEVES = 3;
+
+    std::atomic<bool> done{false};
+    std::vector<std::vector<int>> stolen(THIEVES);
+    std::vector<std::thread> thieves;
+
+    for (int i = 0; i < THIEVES; i++) {
+        thieves.emplace_back([&, i] {
+            while (!done.load() || !deque.empty()) {
+                if (auto x = deque.steal())
+                    stolen[i].push_back(*x);
+                else
+                    std::this_thread::yield();
+            }
+        });
+    }
+
+    /* The owner mixes pushes (which grow the array) with pops */
+    std::vector<int> taken;
+    for (int i = 0; i < N; i++) {
+        deque.push_back(i);
+        if (i % 3 == 0)
+            if (auto x = deque.remove_back())
+                taken.push_back(*x);
+    }
+    while (auto x = deque.remove_back())
+        taken.push_back(*x);
+
+    done = true;
+    for (auto& t : thieves)
+        t.join();
+
+    for (auto& s : stolen)
+        taken.insert(taken.end(), s.begin(), s.end());
+
+    std::sort(taken.begin(), taken.end());
+    REQUIRE(taken.size() == N);
+    for (int i = 0; i < N; i++)
+        REQUIRE(taken[i] == i);
+}
@@ -0,0 +1,56 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BST.hpp"
+#include "arena_bst.hpp"
+
+/* Build a tree of n random keys, search every key, and tear the tree down,
+ * with unique_ptr nodes (BST) and arena nodes (ArenaBST). Keys are shuffled
+ * so that neither tree degenerates.
+ * Usage: arena_bench [n] */
+
+template <typename F>
+double ms(F f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+template <typename Tree>
+void run(const char* name, const std::vector<int>& keys) {
+    auto bt = std::make_unique<Tree>();
+    size_t found = 0;
+
+    double build = ms([&] { for (int k : keys) bt->insert(k); });
+    double search = ms([&] { for (int k : keys) found += bt->search(k); });
+    double teardown = ms([&] { bt.reset(); });
+
+    if (found != keys.size())
+        std::cerr << "unexpected result\n";
+
+    std::cout << std::left << std::setw(12) << name << std::right << std::fixed
+              << std::setprecision(1) << std::setw(12) << build << std::setw(12) << search
+              << std::setw(12) << teardown << '\n';
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = argc > 1 ? std::stoul(argv[1]) : 4000000;
+
+    std::vector<int> keys(n);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(18));
+
+    std::cout << n << " keys\n"
+              << std::left << std::setw(12) << "nodes" << std::right << std::setw(12)
+              << "build ms" << std::setw(12) << "search ms" << std::setw(12) << "free ms" << '\n';
+
+    run<BST<int>>("unique_ptr", keys);
+    run<ArenaBST<int>>("arena", keys);
+}
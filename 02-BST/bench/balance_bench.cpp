@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BST.hpp"
+
+/* Insert, search and remove n keys given in sorted, reverse sorted and
+ * random order, with each balancing policy, and print the time per
+ * operation and the height of the tree after the insertions. Unbalanced
+ * trees are quadratic on sorted input, so they only get n / 10 keys.
+ * Usage: balance_bench [n] */
+
+template <typename T>
+size_t height(const std::unique_ptr<TreeNode<T>>& root) {
+    /* Iterative, since an unbalanced tree can be a long list */
+    size_t best = 0;
+    std::vector<std::pair<const TreeNode<T>*, size_t>> stack;
+    if (root)
+        stack.emplace_back(root.get(), 1);
+    while (!stack.empty()) {
+        auto [t, depth] = stack.back();
+        stack.pop_back();
+        best = std::max(best, depth);
+        if (t->left)
+            stack.emplace_back(t->left.get(), depth + 1);
+        if (t->right)
+            stack.emplace_back(t->right.get(), depth + 1);
+    }
+    return best;
+}
+
+template <typename F>
+double ns_per_op(F f, size_t ops) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / ops;
+}
+
+template <typename Balance>
+void run(const char* policy, const char* order, std::vector<int> keys) {
+    BST<int, Balance> bt;
+    size_t found = 0;
+
+    double insert = ns_per_op([&] { for (int k : keys) bt.insert(k); }, keys.size());
+    size_t h = height(bt.root);
+    double search = ns_per_op([&] { for (int k : keys) found += bt.search(k); }, keys.size());
+    double remove = ns_per_op([&] { for (int k : keys) bt.remove(k); }, keys.size());
+
+    if (found != keys.size())
+        std::cerr << "unexpected result\n";
+
+    std::cout << std::left << std::setw(12) << policy << std::setw(10) << order << std::right
+              << std::setw(10) << keys.size() << std::fixed << std::setprecision(1)
+              << std::setw(12) << insert << std::setw(12) << search << std::setw(12) << remove
+              << std::setw(10) << h << '\n';
+}
+
+template <typename Balance>
+void orders(const char* policy, size_t n) {
+    std::vector<int> sorted(n);
+    std::iota(sorted.begin(), sorted.end(), 0);
+
+    std::vector<int> reversed(sorted.rbegin(), sorted.rend());
+
+    std::vector<int> shuffled = sorted;
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(17));
+
+    run<Balance>(policy, "sorted", sorted);
+    run<Balance>(policy, "reverse", reversed);
+    run<Balance>(policy, "random", shuffled);
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = argc > 1 ? std::stoul(argv[1]) : 1000000;
+
+    std::cout << std::left << std::setw(12) << "policy" << std::setw(10) << "order" << std::right
+              << std::setw(10) << "keys" << std::setw(12) << "insert ns" << std::setw(12)
+              << "search ns" << std::setw(12) << "remove ns" << std::setw(10) << "height" << '\n';
+
+    orders<Unbalanced>("unbalanced", n / 10);
+    orders<ScapegoatBalance>("scapegoat", n);
+    orders<TreapBalance>("treap", n);
+}
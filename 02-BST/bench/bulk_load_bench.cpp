@@ -0,0 +1,67 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "BST.hpp"
+
+/* Rebuilding a tree from a sorted snapshot: n insert() calls against one
+ * build_from_sorted(), and merging two trees of n keys with merge() against
+ * inserting the keys of one into the other. Unbalanced insertion is
+ * quadratic on sorted keys, so it only gets n / 10 keys.
+ * Usage: bulk_load_bench [n] */
+
+template <typename F>
+double ms(F f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+template <typename Balance>
+void run(const char* policy, size_t n) {
+    std::vector<int> evens(n), odds(n);
+    std::iota(evens.begin(), evens.end(), 0);
+    for (size_t i = 0; i < n; i++) {
+        evens[i] *= 2;
+        odds[i] = evens[i] + 1;
+    }
+
+    double inserted = ms([&] {
+        BST<int, Balance> bt;
+        for (int k : evens)
+            bt.insert(k);
+    });
+    double built = ms([&] {
+        auto bt = BST<int, Balance>::build_from_sorted(evens.begin(), evens.end());
+    });
+
+    auto a = BST<int, Balance>::build_from_sorted(evens.begin(), evens.end());
+    auto b = BST<int, Balance>::build_from_sorted(odds.begin(), odds.end());
+    double insert_merge = ms([&] {
+        for (int k : b.to_sorted_vector())
+            a.insert(k);
+    });
+
+    a = BST<int, Balance>::build_from_sorted(evens.begin(), evens.end());
+    double merged = ms([&] { a.merge(b); });
+
+    std::cout << std::left << std::setw(12) << policy << std::right << std::setw(10) << n
+              << std::fixed << std::setprecision(1) << std::setw(12) << inserted << std::setw(12)
+              << built << std::setw(14) << insert_merge << std::setw(12) << merged << '\n';
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = argc > 1 ? std::stoul(argv[1]) : 1000000;
+
+    std::cout << std::left << std::setw(12) << "policy" << std::right << std::setw(10) << "keys"
+              << std::setw(12) << "insert ms" << std::setw(12) << "build ms" << std::setw(14)
+              << "insert-merge" << std::setw(12) << "merge ms" << '\n';
+
+    run<Unbalanced>("unbalanced", n / 10);
+    run<ScapegoatBalance>("scapegoat", n);
+    run<TreapBalance>("treap", n);
+}
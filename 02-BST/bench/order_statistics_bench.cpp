@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BST.hpp"
+
+/* rank, select and count_range on a treap of n keys, against the same
+ * queries answered by an in-order scan of the tree with the cursor (what a
+ * caller had to do before the subtree sizes). The scans are O(n) per query,
+ * so they get fewer queries.
+ * Usage: order_statistics_bench [n] [queries] */
+
+template <typename F>
+double ns_per_query(F f, size_t queries) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / queries;
+}
+
+volatile size_t sink;
+
+int main(int argc, char* argv[]) {
+    size_t n = argc > 1 ? std::stoul(argv[1]) : 1000000;
+    size_t queries = argc > 2 ? std::stoul(argv[2]) : 1000000;
+    size_t scans = std::max<size_t>(1, queries / 10000);
+
+    std::vector<int> keys(n);
+    std::iota(keys.begin(), keys.end(), 0);
+    for (auto& k : keys)
+        k *= 2;
+    auto bt = BST<int, TreapBalance>::build_from_sorted(keys.begin(), keys.end());
+
+    std::mt19937 gen(20);
+    std::vector<int> probes(queries);
+    for (auto& p : probes)
+        p = gen() % (2 * n);
+
+    std::cout << n << " keys\n"
+              << std::left << std::setw(14) << "query" << std::right << std::setw(14)
+              << "tree ns" << std::setw(14) << "scan ns" << '\n';
+
+    size_t total = 0;
+    double rank = ns_per_query([&] { for (int p : probes) total += bt.rank(p); }, queries);
+    double rank_scan = ns_per_query([&] {
+        for (size_t i = 0; i < scans; i++) {
+            size_t r = 0;
+            for (auto it = bt.begin(); it != bt.end() && *it < probes[i]; ++it)
+                r++;
+            total += r;
+        }
+    }, scans);
+
+    double select = ns_per_query([&] { for (int p : probes) total += *bt.select(p % n); }, queries);
+    double select_scan = ns_per_query([&] {
+        for (size_t i = 0; i < scans; i++)
+            total += *std::next(bt.begin(), probes[i] % n);
+    }, scans);
+
+    double range = ns_per_query([&] {
+        for (int p : probes)
+            total += bt.count_range(p, p + 1000);
+    }, queries);
+    double range_scan = ns_per_query([&] {
+        for (size_t i = 0; i < scans; i++) {
+            size_t c = 0;
+            for (auto it = bt.begin(); it != bt.end() && *it < probes[i] + 1000; ++it)
+                c += *it >= probes[i];
+            total += c;
+        }
+    }, scans);
+    sink = total;
+
+    std::cout << std::fixed << std::setprecision(1)
+              << std::left << std::setw(14) << "rank" << std::right << std::setw(14) << rank
+              << std::setw(14) << rank_scan << '\n'
+              << std::left << std::setw(14) << "select" << std::right << std::setw(14) << select
+              << std::setw(14) << select_scan << '\n'
+              << std::left << std::setw(14) << "count_range" << std::right << std::setw(14)
+              << range << std::setw(14) << range_scan << '\n';
+}
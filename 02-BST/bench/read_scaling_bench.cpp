@@ -0,0 +1,119 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BST.hpp"
+#include "concurrent_bst.hpp"
+
+/* Read scaling under a busy writer: 1, 2, 4, ... 64 reader threads search
+ * random keys while one writer keeps inserting and removing keys, for a fixed
+ * time per point. ConcurrentBST is compared with a BST behind one mutex,
+ * which readers and the writer all take.
+ * Usage: read_scaling_bench [n] [milliseconds per point] */
+
+template <typename T>
+class LockedBST
+{
+    public:
+        bool search(const T& key) {
+            std::lock_guard<std::mutex> lock(mutex);
+            return bt.search(key);
+        }
+        bool insert(const T& key) {
+            std::lock_guard<std::mutex> lock(mutex);
+            return bt.insert(key);
+        }
+        bool remove(const T& key) {
+            std::lock_guard<std::mutex> lock(mutex);
+            return bt.remove(key);
+        }
+
+    private:
+        std::mutex mutex;
+        BST<T> bt;
+};
+
+/* Keeps the searches alive; readers add to it from their own threads */
+std::atomic<size_t> sink{0};
+
+struct Result
+{
+    double reads;
+    double writes;
+};
+
+template <typename Tree>
+Result run(Tree& tree, int n, unsigned readers, std::chrono::milliseconds duration) {
+    std::atomic<bool> done{false};
+    std::atomic<size_t> reads{0};
+    size_t writes = 0;
+
+    std::vector<std::thread> threads;
+    for (unsigned r = 0; r < readers; r++) {
+        threads.emplace_back([&, r] {
+            std::mt19937 gen(r);
+            size_t count = 0, found = 0;
+            while (!done.load(std::memory_order_relaxed)) {
+                found += tree.search(gen() % (2 * n));
+                count++;
+            }
+            reads += count;
+            sink.fetch_add(found, std::memory_order_relaxed);
+        });
+    }
+
+    std::mt19937 gen(21);
+    auto start = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - start < duration) {
+        for (int i = 0; i < 64; i++, writes++) {
+            int key = gen() % (2 * n);
+            if (gen() % 2)
+                tree.insert(key);
+            else
+                tree.remove(key);
+        }
+    }
+    done = true;
+    for (auto& t : threads)
+        t.join();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return {reads / elapsed.count() / 1e6, writes / elapsed.count() / 1e6};
+}
+
+int main(int argc, char* argv[]) {
+    int n = argc > 1 ? std::stoi(argv[1]) : 1000000;
+    std::chrono::milliseconds duration(argc > 2 ? std::stoi(argv[2]) : 500);
+
+    std::vector<int> keys(n);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(21));
+
+    ConcurrentBST<int> concurrent;
+    LockedBST<int> locked;
+    for (int k : keys) {
+        concurrent.insert(2 * k);
+        locked.insert(2 * k);
+    }
+
+    std::cout << n << " keys, " << std::thread::hardware_concurrency() << " hardware threads\n"
+              << std::setw(8) << "readers" << std::setw(16) << "lock-free Mr/s"
+              << std::setw(14) << "writer Mw/s" << std::setw(14) << "mutex Mr/s"
+              << std::setw(14) << "writer Mw/s" << '\n';
+
+    for (unsigned readers = 1; readers <= 64; readers *= 2) {
+        Result c = run(concurrent, n, readers, duration);
+        Result l = run(locked, n, readers, duration);
+        std::cout << std::fixed << std::setprecision(2) << std::setw(8) << readers
+                  << std::setw(16) << c.reads << std::setw(14) << c.writes << std::setw(14)
+                  << l.reads << std::setw(14) << l.writes << '\n';
+    }
+}
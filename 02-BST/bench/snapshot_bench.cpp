@@ -0,0 +1,77 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BST.hpp"
+#include "persistent_bst.hpp"
+
+/* Point-in-time snapshots while updates continue: n random updates on a tree
+ * of n keys, with a snapshot kept every `every` updates. With BST a snapshot
+ * is a deep copy (to_sorted_vector and build_from_sorted); with
+ * PersistentBST it is a copy of the version, and each update path-copies.
+ * Usage: snapshot_bench [n] [every] */
+
+template <typename F>
+double ms(F f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+int main(int argc, char* argv[]) {
+    int n = argc > 1 ? std::stoi(argv[1]) : 1000000;
+    int every = argc > 2 ? std::stoi(argv[2]) : 10000;
+
+    std::vector<int> keys(n);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(22));
+
+    std::mt19937 gen(22);
+    std::vector<int> updates(n);
+    for (auto& u : updates)
+        u = gen() % (2 * n);
+
+    size_t snapshots = 0;
+
+    BST<int> bt;
+    for (int k : keys)
+        bt.insert(k);
+    std::vector<BST<int>> copies;
+    double deep = ms([&] {
+        for (int i = 0; i < n; i++) {
+            if (i % 2)
+                bt.insert(updates[i]);
+            else
+                bt.remove(updates[i]);
+            if (i % every == 0) {
+                std::vector<int> sorted = bt.to_sorted_vector();
+                copies.push_back(BST<int>::build_from_sorted(sorted.begin(), sorted.end()));
+                snapshots++;
+            }
+        }
+    });
+
+    PersistentBST<int> pt;
+    for (int k : keys)
+        pt = pt.insert(k);
+    std::vector<PersistentBST<int>> versions;
+    double persistent = ms([&] {
+        for (int i = 0; i < n; i++) {
+            pt = i % 2 ? pt.insert(updates[i]) : pt.remove(updates[i]);
+            if (i % every == 0)
+                versions.push_back(pt);
+        }
+    });
+
+    std::cout << n << " keys, " << n << " updates, " << snapshots << " snapshots\n"
+              << std::left << std::setw(16) << "deep copies" << std::right << std::fixed
+              << std::setprecision(1) << std::setw(10) << deep << " ms\n"
+              << std::left << std::setw(16) << "persistent" << std::right << std::setw(10)
+              << persistent << " ms\n";
+}
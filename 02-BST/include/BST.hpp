@@ -1,9 +1,18 @@
+#ifndef _BST_H
+#define _BST_H
+
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <vector>
 #include <functional>
 #include <iterator>
 #include <memory>
+#include <random>
+#include <type_traits>
 
 
 template <typename T>
@@ -13,166 +22,699 @@ class TreeNode
         T element;
         std::unique_ptr<TreeNode<T>> left;
         std::unique_ptr<TreeNode<T>> right;
+        // number of nodes in the subtree rooted here, kept up to date by
+        // every insert and remove
+        size_t size;
 
         TreeNode<T>(const T& e)
-            :element{e}, left{nullptr}, right{nullptr} {}
+            :element{e}, left{nullptr}, right{nullptr}, size{1} {}
 
         ~TreeNode() {}
 
 };
 
-
 template <typename T>
-struct BST
-{
-    public:
-        std::unique_ptr<TreeNode<T>> root = nullptr;
+using TreeLink = std::unique_ptr<TreeNode<T>>;
 
-        ~BST() {}
 
-        bool insert(const T& key);
-        bool search(const T& key);
-        bool remove(const T& key);
+/* Helpers shared by BST and its balancing policies. None of them recurse
+   deeper than the height of the tree. */
+namespace bst_detail {
 
-    private:
-        bool insert(std::unique_ptr<TreeNode<T>>& t, const T& key);
-        bool search(std::unique_ptr<TreeNode<T>>& t, const T& key);
-        bool remove(std::unique_ptr<TreeNode<T>>& t, const T& key);
-        std::unique_ptr<TreeNode<T>>& FindMaxLSubTree(std::unique_ptr<TreeNode<T>>& t);
+/* The link that holds `key`, or the empty link where it would go */
+template <typename T>
+TreeLink<T>& find_link(TreeLink<T>& root, const T& key) {
+    TreeLink<T>* t = &root;
 
-};
+    while (*t && (*t)->element != key) {
+        if ((*t)->element > key)
+            t = &(*t)->left;
+        else
+            t = &(*t)->right;
+    }
+
+    return *t;
+}
 
 template <typename T>
-bool BST<T>::insert(const T& key) {
-    return insert(root, key);
+size_t size_of(const TreeLink<T>& t) {
+    return t ? t->size : 0;
 }
 
 template <typename T>
-bool BST<T>::search(const T& key) {
-    return search(root, key);
+void update_size(TreeNode<T>* t) {
+    t->size = 1 + size_of(t->left) + size_of(t->right);
 }
 
+/* Like find_link, for a key known to be absent (grow) or present (!grow):
+   every node passed on the way gains (or loses) one from its size. */
 template <typename T>
-bool BST<T>::remove(const T& key) {
-    return remove(root, key);
+TreeLink<T>& resize_path(TreeLink<T>& root, const T& key, bool grow) {
+    TreeLink<T>* t = &root;
+
+    while (*t && (*t)->element != key) {
+        if (grow)
+            (*t)->size++;
+        else
+            (*t)->size--;
+
+        if ((*t)->element > key)
+            t = &(*t)->left;
+        else
+            t = &(*t)->right;
+    }
+
+    return *t;
 }
 
+/* The link holding the maximum of the subtree at t. The maximum is about to
+   be spliced out, so the nodes passed on the way lose one from their size. */
 template <typename T>
-std::unique_ptr<TreeNode<T>>& BST<T>::FindMaxLSubTree(std::unique_ptr<TreeNode<T>>& t){
-    if(t->right == nullptr) {
-        return t;
+TreeLink<T>& FindMaxLSubTree(TreeLink<T>& t) {
+    TreeLink<T>* max = &t;
+
+    while ((*max)->right != nullptr) {
+        (*max)->size--;
+        max = &(*max)->right;
     }
 
+    return *max;
+}
+
+/* Remove the node at the (non-empty) link t. The sizes above t must already
+   account for it (see resize_path). */
+template <typename T>
+void remove_link(TreeLink<T>& t) {
+    // 1. is a leaf, or 2. has one child: the child (if any) takes its place
+    if (t->left == nullptr)
+        t = std::move(t->right);
+    else if (t->right == nullptr)
+        t = std::move(t->left);
+
+    // 3. has two children
     else {
-        return FindMaxLSubTree(t->right);
+        t->size--;
+        // find maximum of L_subtree
+        TreeLink<T>& SwapNode = FindMaxLSubTree(t->left);
+        t->element = std::move(SwapNode->element);
+        SwapNode = std::move(SwapNode->left);
     }
 }
 
+/* Move the nodes of the subtree at t to `nodes`, in order, leaving t empty.
+   Left children are rotated up first, so this needs no stack. */
 template <typename T>
-bool BST<T>::insert(std::unique_ptr<TreeNode<T>>& t, const T& key) {
+void flatten(TreeLink<T>& t, std::vector<TreeLink<T>>& nodes) {
+    while (t) {
+        if (t->left) {
+            TreeLink<T> l = std::move(t->left);
+            t->left = std::move(l->right);
+            l->right = std::move(t);
+            t = std::move(l);
+        } else {
+            TreeLink<T> node = std::move(t);
+            t = std::move(node->right);
+            nodes.push_back(std::move(node));
+        }
+    }
+}
 
-    // TODO
-    // if insertion fails (i.e. if the key already exists in tree), return false
-    // otherwise, return true
+/* A perfectly balanced tree of nodes[lo, hi) */
+template <typename T>
+TreeLink<T> build_balanced(std::vector<TreeLink<T>>& nodes, size_t lo, size_t hi) {
+    if (lo == hi)
+        return nullptr;
+
+    size_t mid = lo + (hi - lo) / 2;
+    TreeLink<T> t = std::move(nodes[mid]);
+    t->left = build_balanced(nodes, lo, mid);
+    t->right = build_balanced(nodes, mid + 1, hi);
+    t->size = hi - lo;
+    return t;
+}
+
+} // namespace bst_detail
+
+
+/* Balancing policies for BST<T, Balance>. A policy owns the shape of the
+ * tree: BST forwards insert and remove to it, with the root link, and both
+ * return false like BST does. Search and the cursor are the same for every
+ * policy. A policy assumes that every change to the tree goes through it.
+ */
 
-    // insert node
-    if(t == nullptr){
-        t = std::make_unique< TreeNode<T> >(key);
+/* No balancing: sorted input builds a linked list */
+struct Unbalanced
+{
+    template <typename T>
+    bool insert(TreeLink<T>& root, const T& key) {
+        if (bst_detail::find_link(root, key) != nullptr)
+            return false;
+
+        bst_detail::resize_path(root, key, true) = std::make_unique< TreeNode<T> >(key);
         return true;
     }
 
-    // there are nodes
-    else {
-        if(t->element == key)
+    template <typename T>
+    bool remove(TreeLink<T>& root, const T& key) {
+        if (bst_detail::find_link(root, key) == nullptr)
             return false;
-        
-        else if(t->element > key){
-            return insert(t->left, key);
+
+        bst_detail::remove_link(bst_detail::resize_path(root, key, false));
+        return true;
+    }
+
+    /* Replace the tree with the sorted, distinct `nodes` */
+    template <typename T>
+    void build(TreeLink<T>& root, std::vector<TreeLink<T>>& nodes) {
+        root = bst_detail::build_balanced(nodes, 0, nodes.size());
+    }
+};
+
+/* Scapegoat tree (Galperin and Rivest) with alpha = 2/3.
+ *
+ * Nodes carry nothing extra. An insertion that lands deeper than
+ * log_{3/2}(size) walks back up its path to the first ancestor whose child
+ * on the path holds more than 2/3 of its nodes (the scapegoat), and rebuilds
+ * that subtree perfectly balanced. When removals bring the size below 2/3 of
+ * its maximum since the last full rebuild, the whole tree is rebuilt. The
+ * height stays below log_{3/2}(n) + 2, so the insertion path fits in a fixed
+ * array and all operations take O(log n) amortized.
+ */
+struct ScapegoatBalance
+{
+    template <typename T>
+    bool insert(TreeLink<T>& root, const T& key) {
+        std::array<TreeLink<T>*, max_depth> path;
+        size_t depth = 0;
+
+        TreeLink<T>* t = &root;
+        while (*t) {
+            if ((*t)->element == key)
+                return false;
+            path[depth++] = t;
+            t = (*t)->element > key ? &(*t)->left : &(*t)->right;
         }
 
-        else {  // if(t->element < key)
-            return insert(t->right, key);
+        *t = std::make_unique< TreeNode<T> >(key);
+        for (size_t i = 0; i < depth; i++)
+            (*path[i])->size++;
+        size_++;
+        max_size_ = std::max(max_size_, size_);
+
+        if (depth <= height_bound(size_))
+            return true;
+
+        /* Look for the scapegoat from the new node up */
+        for (size_t i = depth; i-- > 0;) {
+            size_t child_size = (i + 1 < depth ? *path[i + 1] : *t)->size;
+            size_t parent_size = (*path[i])->size;
+
+            if (3 * child_size > 2 * parent_size) {
+                rebuild(*path[i], parent_size);
+                break;
+            }
         }
+        return true;
     }
 
-}
+    template <typename T>
+    bool remove(TreeLink<T>& root, const T& key) {
+        if (bst_detail::find_link(root, key) == nullptr)
+            return false;
 
-template <typename T>
-bool BST<T>::search(std::unique_ptr<TreeNode<T>>& t, const T& key) {
+        bst_detail::remove_link(bst_detail::resize_path(root, key, false));
+        size_--;
 
-    // TODO
-    // if key exists in tree, return true
-    // otherwise, return false
+        if (3 * size_ < 2 * max_size_) {
+            rebuild(root, size_);
+            max_size_ = size_;
+        }
+        return true;
+    }
 
-    if(t == nullptr){
-        return false;
+    template <typename T>
+    void build(TreeLink<T>& root, std::vector<TreeLink<T>>& nodes) {
+        root = bst_detail::build_balanced(nodes, 0, nodes.size());
+        size_ = max_size_ = nodes.size();
     }
 
-    else {
-        if(t->element == key)
-            return true;
-        
-        else if(t->element > key)
-            return search(t->left, key);
-        
-        else
-            return search(t->right, key);
+    size_t size() const { return size_; }
+
+    /* floor(log_{3/2}(n)) fits in max_depth for any 64-bit size */
+    static constexpr size_t max_depth = 128;
+
+    static size_t height_bound(size_t n) {
+        return static_cast<size_t>(std::log(static_cast<double>(n)) / std::log(1.5));
     }
 
-}
+    template <typename T>
+    static void rebuild(TreeLink<T>& t, size_t n) {
+        std::vector<TreeLink<T>> nodes;
+        nodes.reserve(n);
+        bst_detail::flatten(t, nodes);
+        t = bst_detail::build_balanced(nodes, 0, nodes.size());
+    }
 
-template <typename T>
-bool BST<T>::remove(std::unique_ptr<TreeNode<T>>& t, const T& key) {
+    size_t size_ = 0;
+    size_t max_size_ = 0;
+};
 
-    // TODO
-    // if key does not exist in tree, return false
-    // otherwise, return true
+/* Randomized treap: the nodes are also a max-heap on a priority drawn per key,
+ * so the tree has the shape of a BST built by inserting the keys in random
+ * order, and its height is O(log n) with high probability whatever the
+ * insertion order.
+ *
+ * The priority is not stored: it is a hash of the key, mixed with a seed
+ * drawn per tree so that the input cannot be chosen to defeat it. An insertion
+ * walks down until the new key outranks the node in its way, and splits
+ * that subtree around the key. A removal merges the two subtrees of the
+ * removed node. Split and merge recurse once per level.
+ */
+struct TreapBalance
+{
+    TreapBalance() : seed{std::random_device{}()} {}
+    explicit TreapBalance(uint64_t seed) : seed{seed} {}
 
-    // not in tree
-    if(t == nullptr)
-        return false;
+    template <typename T>
+    bool insert(TreeLink<T>& root, const T& key) {
+        if (bst_detail::find_link(root, key) != nullptr)
+            return false;
 
-    // found
-    else if(t->element == key){
-        // 1. is a leaf
-        if(t->left == nullptr && t->right == nullptr){
-            t.reset();
-            return true;
+        uint64_t p = priority(key);
+        TreeLink<T>* t = &root;
+        while (*t && priority((*t)->element) > p) {
+            (*t)->size++;
+            t = (*t)->element > key ? &(*t)->left : &(*t)->right;
         }
-    
-        // 2. has one child
-        else if(t->left == nullptr || t->right == nullptr){
-            // has left child
-            if(t->right == nullptr){
-                t = std::move(t->left);
-                return true;
-            }
 
-            // has right child
-            else{   // t->left == nullptr
-                t = std::move(t->right);
-                return true;
+        TreeLink<T> node = std::make_unique< TreeNode<T> >(key);
+        split(std::move(*t), key, node->left, node->right);
+        bst_detail::update_size(node.get());
+        *t = std::move(node);
+        return true;
+    }
+
+    template <typename T>
+    bool remove(TreeLink<T>& root, const T& key) {
+        if (bst_detail::find_link(root, key) == nullptr)
+            return false;
+
+        TreeLink<T>& t = bst_detail::resize_path(root, key, false);
+
+        TreeLink<T> merged = merge(std::move(t->left), std::move(t->right));
+        t = std::move(merged);
+        return true;
+    }
+
+    /* A Cartesian tree on the priorities, built left to right in O(n): each
+       node pops the right spine nodes it outranks and adopts them as its
+       left subtree. A popped subtree is final, so its sizes are set then. */
+    template <typename T>
+    void build(TreeLink<T>& root, std::vector<TreeLink<T>>& nodes) {
+        std::vector<TreeNode<T>*> spine;
+        root = nullptr;
+
+        for (TreeLink<T>& node : nodes) {
+            uint64_t p = priority(node->element);
+            size_t k = spine.size();
+            while (k > 0 && priority(spine[k - 1]->element) < p) {
+                bst_detail::update_size(spine[k - 1]);
+                k--;
             }
+
+            TreeLink<T>& link = k == 0 ? root : spine[k - 1]->right;
+            node->left = std::move(link);
+            node->right = nullptr;
+            spine.resize(k);
+            spine.push_back(node.get());
+            link = std::move(node);
         }
 
-        // 3. has two children
-        else {
-            // find maximum of L_subtree
-            std::unique_ptr<TreeNode<T>>& SwapNode = FindMaxLSubTree(t->left);
-            t->element = SwapNode->element;
-            SwapNode = std::move(SwapNode->left);
-            return true;
+        for (size_t k = spine.size(); k-- > 0;)
+            bst_detail::update_size(spine[k]);
+    }
+
+    template <typename T>
+    uint64_t priority(const T& key) const {
+        /* splitmix64 finalizer */
+        uint64_t z = static_cast<uint64_t>(std::hash<T>{}(key)) ^ seed;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    /* Keys < key go to l, the others to r */
+    template <typename T>
+    void split(TreeLink<T> t, const T& key, TreeLink<T>& l, TreeLink<T>& r) const {
+        if (!t) {
+            l = nullptr;
+            r = nullptr;
+        } else if (t->element < key) {
+            split(std::move(t->right), key, t->right, r);
+            bst_detail::update_size(t.get());
+            l = std::move(t);
+        } else {
+            split(std::move(t->left), key, l, t->left);
+            bst_detail::update_size(t.get());
+            r = std::move(t);
+        }
+    }
+
+    /* Every key of l is less than every key of r */
+    template <typename T>
+    TreeLink<T> merge(TreeLink<T> l, TreeLink<T> r) const {
+        if (!l)
+            return r;
+        if (!r)
+            return l;
+
+        if (priority(l->element) > priority(r->element)) {
+            l->right = merge(std::move(l->right), std::move(r));
+            bst_detail::update_size(l.get());
+            return l;
+        } else {
+            r->left = merge(std::move(l), std::move(r->left));
+            bst_detail::update_size(r.get());
+            return r;
         }
     }
-        
-    // didn't found
-    else{
-        // key is bigger than node
-        if(key > t->element){
-            return remove(t->right, key);
+
+    uint64_t seed;
+};
+
+
+template <typename T, typename Balance = Unbalanced>
+struct BST
+{
+    public:
+        std::unique_ptr<TreeNode<T>> root = nullptr;
+
+        BST() = default;
+        explicit BST(Balance balance) : balance{std::move(balance)} {}
+        BST(BST&&) = default;
+        BST& operator=(BST&& other);
+        ~BST();
+
+        /* A tree of the keys of the sorted range [first, last) in O(n),
+           balanced by the policy (perfectly balanced unless it is a treap).
+           Repeated keys are kept once. */
+        template <typename It>
+        static BST build_from_sorted(It first, It last, Balance balance = Balance{});
+
+        bool insert(const T& key);
+        bool search(const T& key);
+        bool remove(const T& key);
+
+        /* The keys in order, in O(n) */
+        std::vector<T> to_sorted_vector() const;
+
+        /* Move every key of `other` into this tree, leaving `other` empty.
+           Both trees are flattened into their nodes, which are merged and
+           rebuilt in O(n + m), with no node allocated or freed (except the
+           duplicates). */
+        void merge(BST& other);
+
+        /* In-order cursor over the keys. It keeps the ancestors it still has
+           to visit (those whose left subtree it is in) on a stack bounded by
+           the height, so ++ is O(1) amortized and a full scan is O(n) even
+           on a degenerate tree. Inserting or removing keys invalidates it. */
+        class const_iterator;
+        using iterator = const_iterator;
+
+        const_iterator begin() const;
+        const_iterator end() const;
+
+        /* First key >= key (lower_bound) or > key (upper_bound) */
+        const_iterator lower_bound(const T& key) const;
+        const_iterator upper_bound(const T& key) const;
+
+        /* Order statistics from the subtree sizes, in O(height) */
+        size_t size() const { return bst_detail::size_of(root); }
+        /* Number of keys < key */
+        size_t rank(const T& key) const;
+        /* The k-th smallest key (from 0), or end() if k >= size() */
+        const_iterator select(size_t k) const;
+        /* Number of keys in [lo, hi) */
+        size_t count_range(const T& lo, const T& hi) const;
+
+    private:
+        Balance balance;
+
+};
+
+template <typename T, typename Balance>
+class BST<T, Balance>::const_iterator
+{
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() = default;
+
+        reference operator*() const { return path.back()->element; }
+        pointer operator->() const { return &path.back()->element; }
+
+        const_iterator& operator++() {
+            const TreeNode<T>* t = path.back()->right.get();
+            path.pop_back();
+            descend_left(t);
+            return *this;
         }
-        else {  // if(t->element < key)
-            return remove(t->left, key);
+
+        const_iterator operator++(int) {
+            const_iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const const_iterator& other) const { return current() == other.current(); }
+        bool operator!=(const const_iterator& other) const { return current() != other.current(); }
+
+    private:
+        friend struct BST<T, Balance>;
+
+        const TreeNode<T>* current() const { return path.empty() ? nullptr : path.back(); }
+
+        void descend_left(const TreeNode<T>* t) {
+            for (; t; t = t->left.get())
+                path.push_back(t);
+        }
+
+        // The node the cursor is on, at the back, and the ancestors it comes
+        // back to later; empty at end()
+        std::vector<const TreeNode<T>*> path;
+};
+
+/* Destroying the root would free the tree recursively, one stack frame per
+   level. Rotate left children up instead, so that every node is freed with
+   no left child and its right subtree already moved out. */
+template <typename T, typename Balance>
+BST<T, Balance>::~BST() {
+    while (root) {
+        if (root->left) {
+            std::unique_ptr<TreeNode<T>> l = std::move(root->left);
+            root->left = std::move(l->right);
+            l->right = std::move(root);
+            root = std::move(l);
+        } else {
+            root = std::move(root->right);
         }
     }
-}
\ No newline at end of file
+}
+
+template <typename T, typename Balance>
+BST<T, Balance>& BST<T, Balance>::operator=(BST&& other) {
+    // The old tree goes through ~BST, not through the unique_ptr chain
+    BST old(std::move(*this));
+    root = std::move(other.root);
+    balance = std::move(other.balance);
+    return *this;
+}
+
+template <typename T, typename Balance>
+template <typename It>
+BST<T, Balance> BST<T, Balance>::build_from_sorted(It first, It last, Balance balance) {
+    std::vector<std::unique_ptr<TreeNode<T>>> nodes;
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                                    typename std::iterator_traits<It>::iterator_category>)
+        nodes.reserve(std::distance(first, last));
+
+    for (; first != last; ++first) {
+        if (!nodes.empty() && !(nodes.back()->element < *first))
+            continue;
+        nodes.push_back(std::make_unique< TreeNode<T> >(*first));
+    }
+
+    BST bt(std::move(balance));
+    bt.balance.build(bt.root, nodes);
+    return bt;
+}
+
+template <typename T, typename Balance>
+std::vector<T> BST<T, Balance>::to_sorted_vector() const {
+    std::vector<T> keys;
+    std::vector<const TreeNode<T>*> stack;
+    const TreeNode<T>* t = root.get();
+
+    while (t || !stack.empty()) {
+        while (t) {
+            stack.push_back(t);
+            t = t->left.get();
+        }
+        t = stack.back();
+        stack.pop_back();
+        keys.push_back(t->element);
+        t = t->right.get();
+    }
+    return keys;
+}
+
+template <typename T, typename Balance>
+size_t BST<T, Balance>::rank(const T& key) const {
+    size_t r = 0;
+    const TreeNode<T>* t = root.get();
+
+    while (t) {
+        if (t->element < key) {
+            r += bst_detail::size_of(t->left) + 1;
+            t = t->right.get();
+        } else {
+            t = t->left.get();
+        }
+    }
+    return r;
+}
+
+template <typename T, typename Balance>
+typename BST<T, Balance>::const_iterator BST<T, Balance>::select(size_t k) const {
+    const_iterator it;
+    const TreeNode<T>* t = root.get();
+
+    while (t) {
+        size_t left = bst_detail::size_of(t->left);
+        if (k < left) {
+            it.path.push_back(t);
+            t = t->left.get();
+        } else if (k == left) {
+            it.path.push_back(t);
+            return it;
+        } else {
+            k -= left + 1;
+            t = t->right.get();
+        }
+    }
+    return end();
+}
+
+template <typename T, typename Balance>
+size_t BST<T, Balance>::count_range(const T& lo, const T& hi) const {
+    if (!(lo < hi))
+        return 0;
+    return rank(hi) - rank(lo);
+}
+
+template <typename T, typename Balance>
+void BST<T, Balance>::merge(BST& other) {
+    if (&other == this)
+        return;
+
+    std::vector<std::unique_ptr<TreeNode<T>>> a, b, merged;
+    bst_detail::flatten(root, a);
+    bst_detail::flatten(other.root, b);
+    merged.reserve(a.size() + b.size());
+
+    size_t i = 0, j = 0;
+    while (i < a.size() || j < b.size()) {
+        if (j == b.size() || (i < a.size() && a[i]->element < b[j]->element)) {
+            merged.push_back(std::move(a[i++]));
+        } else if (i == a.size() || b[j]->element < a[i]->element) {
+            merged.push_back(std::move(b[j++]));
+        } else {
+            // In both trees: keep ours
+            merged.push_back(std::move(a[i++]));
+            j++;
+        }
+    }
+
+    balance.build(root, merged);
+    b.clear();
+    other.balance.build(other.root, b);
+}
+
+template <typename T, typename Balance>
+bool BST<T, Balance>::insert(const T& key) {
+
+    // if insertion fails (i.e. if the key already exists in tree), return false
+    // otherwise, return true
+
+    return balance.insert(root, key);
+}
+
+template <typename T, typename Balance>
+bool BST<T, Balance>::search(const T& key) {
+
+    // if key exists in tree, return true
+    // otherwise, return false
+
+    return bst_detail::find_link(root, key) != nullptr;
+}
+
+template <typename T, typename Balance>
+bool BST<T, Balance>::remove(const T& key) {
+
+    // if key does not exist in tree, return false
+    // otherwise, return true
+
+    return balance.remove(root, key);
+}
+
+template <typename T, typename Balance>
+typename BST<T, Balance>::const_iterator BST<T, Balance>::begin() const {
+    const_iterator it;
+    it.descend_left(root.get());
+    return it;
+}
+
+template <typename T, typename Balance>
+typename BST<T, Balance>::const_iterator BST<T, Balance>::end() const {
+    return const_iterator();
+}
+
+template <typename T, typename Balance>
+typename BST<T, Balance>::const_iterator BST<T, Balance>::lower_bound(const T& key) const {
+    // Every node where the search turns left is still to be visited, and
+    // the last of them is the bound
+    const_iterator it;
+    const TreeNode<T>* t = root.get();
+
+    while (t) {
+        if (t->element < key) {
+            t = t->right.get();
+        } else {
+            it.path.push_back(t);
+            t = t->left.get();
+        }
+    }
+    return it;
+}
+
+template <typename T, typename Balance>
+typename BST<T, Balance>::const_iterator BST<T, Balance>::upper_bound(const T& key) const {
+    const_iterator it;
+    const TreeNode<T>* t = root.get();
+
+    while (t) {
+        if (key < t->element) {
+            it.path.push_back(t);
+            t = t->left.get();
+        } else {
+            t = t->right.get();
+        }
+    }
+    return it;
+}
+
+#endif // _BST_H
@@ -0,0 +1,271 @@
+#ifndef _ARENA_BST_H
+#define _ARENA_BST_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+
+/* A BST whose nodes live in one vector (the arena) and link to each other by
+ * 32-bit index instead of by pointer.
+ *
+ * Nodes are allocated by appending to the arena, so a tree built in one go
+ * sits in contiguous memory, and a node costs two 4-byte links instead of two
+ * 8-byte unique_ptrs plus a heap block header. Removed nodes are chained
+ * through their `left` link into a free list and reused by later insertions.
+ *
+ * Nothing is freed node by node: clear() only empties the arena (O(1) for
+ * trivially destructible keys, and never a tree walk), and the destructor is
+ * the vector's. The API is that of BST<T>: insert, search and remove return
+ * bool, and an in-order cursor walks the keys. Like BST<T>'s, it keeps the
+ * ancestors it still has to visit (as indices) on a stack bounded by the
+ * height, so ++ is O(1) amortized, and inserting or removing keys
+ * invalidates it.
+ */
+template <typename T>
+class ArenaBST
+{
+    public:
+        using index_type = uint32_t;
+        static constexpr index_type nil = std::numeric_limits<index_type>::max();
+
+        struct Node
+        {
+            T element;
+            index_type left;
+            index_type right;
+        };
+
+        bool insert(const T& key);
+        bool search(const T& key) const;
+        bool remove(const T& key);
+
+        size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+
+        /* Remove every key in one go */
+        void clear();
+        /* Make room for n nodes, so that building a tree of n keys never
+           moves the arena */
+        void reserve(size_t n) { nodes.reserve(n); }
+
+        class const_iterator;
+        using iterator = const_iterator;
+
+        const_iterator begin() const;
+        const_iterator end() const;
+        const_iterator lower_bound(const T& key) const;
+        const_iterator upper_bound(const T& key) const;
+
+    private:
+        std::vector<Node> nodes;
+        index_type root = nil;
+        index_type free_list = nil;
+        size_t size_ = 0;
+
+        /* The link that holds `key`, or the nil link where it would go */
+        index_type* find_link(const T& key);
+        index_type new_node(const T& key);
+        void free_node(index_type i);
+};
+
+template <typename T>
+class ArenaBST<T>::const_iterator
+{
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() = default;
+
+        reference operator*() const { return tree->nodes[path.back()].element; }
+        pointer operator->() const { return &tree->nodes[path.back()].element; }
+
+        const_iterator& operator++() {
+            index_type t = tree->nodes[path.back()].right;
+            path.pop_back();
+            descend_left(t);
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const const_iterator& other) const { return current() == other.current(); }
+        bool operator!=(const const_iterator& other) const { return current() != other.current(); }
+
+    private:
+        friend class ArenaBST<T>;
+
+        explicit const_iterator(const ArenaBST<T>* tree) : tree{tree} {}
+
+        index_type current() const { return path.empty() ? nil : path.back(); }
+
+        void descend_left(index_type t) {
+            for (; t != nil; t = tree->nodes[t].left)
+                path.push_back(t);
+        }
+
+        const ArenaBST<T>* tree = nullptr;
+        // The node the cursor is on, at the back, and the ancestors it comes
+        // back to later; empty at end()
+        std::vector<index_type> path;
+};
+
+template <typename T>
+typename ArenaBST<T>::index_type* ArenaBST<T>::find_link(const T& key) {
+    index_type* t = &root;
+
+    while (*t != nil && nodes[*t].element != key) {
+        if (nodes[*t].element > key)
+            t = &nodes[*t].left;
+        else
+            t = &nodes[*t].right;
+    }
+
+    return t;
+}
+
+template <typename T>
+typename ArenaBST<T>::index_type ArenaBST<T>::new_node(const T& key) {
+    if (free_list != nil) {
+        index_type i = free_list;
+        free_list = nodes[i].left;
+        nodes[i] = Node{key, nil, nil};
+        return i;
+    }
+
+    if (nodes.size() == nil)
+        throw std::length_error("ArenaBST: too many nodes");
+    nodes.push_back(Node{key, nil, nil});
+    return static_cast<index_type>(nodes.size() - 1);
+}
+
+template <typename T>
+void ArenaBST<T>::free_node(index_type i) {
+    nodes[i].left = free_list;
+    free_list = i;
+}
+
+template <typename T>
+bool ArenaBST<T>::insert(const T& key) {
+    /* Grow the arena first: t points into it */
+    if (free_list == nil && nodes.size() == nodes.capacity())
+        nodes.reserve(std::max<size_t>(64, 2 * nodes.capacity()));
+
+    index_type* t = find_link(key);
+    if (*t != nil)
+        return false;
+
+    *t = new_node(key);
+    size_++;
+    return true;
+}
+
+template <typename T>
+bool ArenaBST<T>::search(const T& key) const {
+    index_type t = root;
+
+    while (t != nil && nodes[t].element != key)
+        t = nodes[t].element > key ? nodes[t].left : nodes[t].right;
+
+    return t != nil;
+}
+
+template <typename T>
+bool ArenaBST<T>::remove(const T& key) {
+    index_type* t = find_link(key);
+    if (*t == nil)
+        return false;
+
+    index_type i = *t;
+    Node& node = nodes[i];
+
+    if (node.left == nil) {
+        *t = node.right;
+        free_node(i);
+    } else if (node.right == nil) {
+        *t = node.left;
+        free_node(i);
+    } else {
+        /* Replace the key with the maximum of the left subtree, and free
+           that node instead */
+        index_type* max = &node.left;
+        while (nodes[*max].right != nil)
+            max = &nodes[*max].right;
+
+        index_type m = *max;
+        node.element = std::move(nodes[m].element);
+        *max = nodes[m].left;
+        free_node(m);
+    }
+
+    size_--;
+    return true;
+}
+
+template <typename T>
+void ArenaBST<T>::clear() {
+    nodes.clear();
+    root = nil;
+    free_list = nil;
+    size_ = 0;
+}
+
+template <typename T>
+typename ArenaBST<T>::const_iterator ArenaBST<T>::begin() const {
+    const_iterator it(this);
+    it.descend_left(root);
+    return it;
+}
+
+template <typename T>
+typename ArenaBST<T>::const_iterator ArenaBST<T>::end() const {
+    return const_iterator(this);
+}
+
+template <typename T>
+typename ArenaBST<T>::const_iterator ArenaBST<T>::lower_bound(const T& key) const {
+    // Every node where the search turns left is still to be visited, and
+    // the last of them is the bound
+    const_iterator it(this);
+    index_type t = root;
+
+    while (t != nil) {
+        if (nodes[t].element < key) {
+            t = nodes[t].right;
+        } else {
+            it.path.push_back(t);
+            t = nodes[t].left;
+        }
+    }
+    return it;
+}
+
+template <typename T>
+typename ArenaBST<T>::const_iterator ArenaBST<T>::upper_bound(const T& key) const {
+    const_iterator it(this);
+    index_type t = root;
+
+    while (t != nil) {
+        if (key < nodes[t].element) {
+            it.path.push_back(t);
+            t = nodes[t].left;
+        } else {
+            t = nodes[t].right;
+        }
+    }
+    return it;
+}
+
+#endif // _ARENA_BST_H
@@ -0,0 +1,261 @@
+#ifndef _CONCURRENT_BST_H
+#define _CONCURRENT_BST_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/* A BST for many readers and one writer at a time.
+ *
+ * search() takes no lock and writes nothing shared but one counter of its
+ * own. insert() and remove() are serialized by a mutex. Links are atomic,
+ * and a node's key never changes once the node is reachable, so a reader
+ * always walks a consistent tree: every change is published by a single
+ * store into a link.
+ *
+ * Removing a node with two children cannot overwrite its key with the
+ * predecessor's, as BST does, since readers may be looking at it. Instead
+ * the writer builds copies of the path from the node down to its predecessor
+ * (the copy of the node carries the predecessor's key), and swings the link
+ * to the copy. Readers already inside the old path still see the old,
+ * consistent subtree.
+ *
+ * Removed nodes are freed by epoch-based reclamation. A reader announces the
+ * parity of the current epoch in its stripe's counter for the duration of a
+ * search. The writer collects removed nodes, and once it has enough of them,
+ * advances the epoch and waits for the counters of the old parity to drain:
+ * every reader that could still see those nodes started before the advance.
+ * Stripes sit on separate cache lines and are handed out to threads round
+ * robin, so readers do not contend with each other.
+ */
+template <typename T>
+class ConcurrentBST
+{
+    public:
+        ConcurrentBST() = default;
+        ~ConcurrentBST();
+
+        ConcurrentBST(const ConcurrentBST&) = delete;
+        ConcurrentBST& operator=(const ConcurrentBST&) = delete;
+
+        /* Any thread, never blocks */
+        bool search(const T& key) const;
+
+        /* One writer at a time; others wait on the mutex */
+        bool insert(const T& key);
+        bool remove(const T& key);
+
+        /* Free the removed nodes now. Waits for the readers in flight. */
+        void synchronize();
+
+        static constexpr size_t stripes = 64;
+        /* Removed nodes collected before the writer waits for a grace period */
+        static constexpr size_t retire_batch = 256;
+
+    private:
+        struct Node
+        {
+            const T element;
+            std::atomic<Node*> left;
+            std::atomic<Node*> right;
+
+            Node(const T& e, Node* l = nullptr, Node* r = nullptr)
+                : element{e}, left{l}, right{r} {}
+        };
+
+        struct alignas(64) Stripe
+        {
+            std::atomic<uint64_t> readers[2] = {0, 0};
+        };
+
+        /* Holds a reader's place in the current epoch */
+        class ReadGuard;
+
+        std::atomic<Node*> root{nullptr};
+
+        std::atomic<uint64_t> epoch{0};
+        mutable Stripe counters[stripes];
+
+        std::mutex writer;
+        std::vector<Node*> retired;
+
+        static size_t my_stripe();
+
+        /* The link holding key, or the empty link where it would go (writer) */
+        std::atomic<Node*>* find_link(const T& key);
+        void retire(Node* node);
+        void reclaim();
+};
+
+template <typename T>
+class ConcurrentBST<T>::ReadGuard
+{
+    public:
+        explicit ReadGuard(const ConcurrentBST& tree) {
+            Stripe& stripe = tree.counters[my_stripe()];
+            while (true) {
+                uint64_t e = tree.epoch.load(std::memory_order_seq_cst);
+                counter = &stripe.readers[e & 1];
+                counter->fetch_add(1, std::memory_order_seq_cst);
+
+                /* The writer may have advanced (and checked our counter)
+                   between the two steps above; then announce again. */
+                if (tree.epoch.load(std::memory_order_seq_cst) == e)
+                    break;
+                counter->fetch_sub(1, std::memory_order_release);
+            }
+        }
+
+        ~ReadGuard() { counter->fetch_sub(1, std::memory_order_release); }
+
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+    private:
+        std::atomic<uint64_t>* counter;
+};
+
+template <typename T>
+size_t ConcurrentBST<T>::my_stripe() {
+    static std::atomic<size_t> next{0};
+    thread_local size_t stripe = next.fetch_add(1, std::memory_order_relaxed) % stripes;
+    return stripe;
+}
+
+template <typename T>
+ConcurrentBST<T>::~ConcurrentBST() {
+    /* No reader may be running any more */
+    for (Node* node : retired)
+        delete node;
+
+    std::vector<Node*> stack;
+    if (Node* r = root.load(std::memory_order_relaxed))
+        stack.push_back(r);
+    while (!stack.empty()) {
+        Node* t = stack.back();
+        stack.pop_back();
+        if (Node* l = t->left.load(std::memory_order_relaxed))
+            stack.push_back(l);
+        if (Node* r = t->right.load(std::memory_order_relaxed))
+            stack.push_back(r);
+        delete t;
+    }
+}
+
+template <typename T>
+bool ConcurrentBST<T>::search(const T& key) const {
+    ReadGuard guard(*this);
+    const Node* t = root.load(std::memory_order_acquire);
+
+    while (t && t->element != key) {
+        if (t->element > key)
+            t = t->left.load(std::memory_order_acquire);
+        else
+            t = t->right.load(std::memory_order_acquire);
+    }
+
+    return t != nullptr;
+}
+
+template <typename T>
+std::atomic<typename ConcurrentBST<T>::Node*>* ConcurrentBST<T>::find_link(const T& key) {
+    /* Only the writer changes links, so relaxed loads see its own stores */
+    std::atomic<Node*>* t = &root;
+    Node* node;
+
+    while ((node = t->load(std::memory_order_relaxed)) && node->element != key) {
+        if (node->element > key)
+            t = &node->left;
+        else
+            t = &node->right;
+    }
+
+    return t;
+}
+
+template <typename T>
+bool ConcurrentBST<T>::insert(const T& key) {
+    std::lock_guard<std::mutex> lock(writer);
+
+    std::atomic<Node*>* t = find_link(key);
+    if (t->load(std::memory_order_relaxed))
+        return false;
+
+    t->store(new Node(key), std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+bool ConcurrentBST<T>::remove(const T& key) {
+    std::lock_guard<std::mutex> lock(writer);
+
+    std::atomic<Node*>* t = find_link(key);
+    Node* x = t->load(std::memory_order_relaxed);
+    if (!x)
+        return false;
+
+    Node* l = x->left.load(std::memory_order_relaxed);
+    Node* r = x->right.load(std::memory_order_relaxed);
+
+    // 1. is a leaf, or 2. has one child: the child (if any) takes its place
+    if (!l || !r) {
+        t->store(l ? l : r, std::memory_order_release);
+        retire(x);
+        return true;
+    }
+
+    // 3. has two children: the path from x to the maximum of its left
+    // subtree is copied, and the copy of x takes the maximum's key
+    std::vector<Node*> path;
+    for (Node* p = l; p; p = p->right.load(std::memory_order_relaxed))
+        path.push_back(p);
+    Node* max = path.back();
+    path.pop_back();
+
+    // Copies of the path, bottom up; the lowest one skips the maximum
+    Node* below = max->left.load(std::memory_order_relaxed);
+    for (size_t i = path.size(); i-- > 0;)
+        below = new Node(path[i]->element, path[i]->left.load(std::memory_order_relaxed), below);
+
+    t->store(new Node(max->element, below, r), std::memory_order_release);
+
+    retire(x);
+    for (Node* p : path)
+        retire(p);
+    retire(max);
+    return true;
+}
+
+template <typename T>
+void ConcurrentBST<T>::retire(Node* node) {
+    retired.push_back(node);
+    if (retired.size() >= retire_batch)
+        reclaim();
+}
+
+/* Writer only. Every node in `retired` was unlinked before the epoch
+   advances, so only readers of the old parity can still hold it. */
+template <typename T>
+void ConcurrentBST<T>::reclaim() {
+    uint64_t old = epoch.fetch_add(1, std::memory_order_seq_cst);
+
+    for (Stripe& stripe : counters)
+        while (stripe.readers[old & 1].load(std::memory_order_acquire) != 0)
+            std::this_thread::yield();
+
+    for (Node* node : retired)
+        delete node;
+    retired.clear();
+}
+
+template <typename T>
+void ConcurrentBST<T>::synchronize() {
+    std::lock_guard<std::mutex> lock(writer);
+    reclaim();
+}
+
+#endif // _CONCURRENT_BST_H
@@ -0,0 +1,199 @@
+#ifndef _PERSISTENT_BST_H
+#define _PERSISTENT_BST_H
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+
+/* A persistent BST: every version of the tree stays valid and readable.
+ *
+ * A PersistentBST is an immutable value. insert() and remove() leave it
+ * alone and return a new version, which copies only the nodes on the path to
+ * the change (O(depth) of them) and shares every other subtree with the old
+ * version through shared_ptr. Taking a snapshot is copying the value: one
+ * reference count. Nodes are never modified once built, so versions can be
+ * read from any number of threads while new versions are made.
+ *
+ * Like BST<T> without a balancing policy, the shape depends on the insertion
+ * order. Releasing a node frees whatever it alone owns iteratively, so even
+ * a degenerate version is destroyed without deep recursion.
+ */
+template <typename T>
+class PersistentBST
+{
+    public:
+        PersistentBST() = default;
+
+        /* A version with key added. If key is already there, the version is
+           this one (see same_version) */
+        [[nodiscard]] PersistentBST insert(const T& key) const;
+        /* A version without key. If key is not there, the version is this one */
+        [[nodiscard]] PersistentBST remove(const T& key) const;
+
+        bool search(const T& key) const;
+
+        size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+
+        /* The keys in order */
+        std::vector<T> to_sorted_vector() const;
+
+        /* Do the two versions share their whole tree? */
+        bool same_version(const PersistentBST& other) const { return root == other.root; }
+
+    private:
+        struct Node;
+        using Link = std::shared_ptr<const Node>;
+
+        struct Node
+        {
+            const T element;
+            // mutable only so that ~Node can take apart children it alone
+            // owns; a node reachable from a version is never changed
+            mutable Link left;
+            mutable Link right;
+
+            Node(const T& e, Link l, Link r)
+                : element{e}, left{std::move(l)}, right{std::move(r)} {}
+
+            ~Node();
+        };
+
+        /* A step down from a node: towards its left child or its right one */
+        using Path = std::vector<std::pair<const Node*, bool>>;
+
+        Link root;
+        size_t size_ = 0;
+
+        PersistentBST(Link root, size_t size) : root{std::move(root)}, size_{size} {}
+
+        /* Copies of the nodes on `path` above `sub`, from the bottom up */
+        static Link copy_path(const Path& path, Link sub);
+};
+
+/* Children that this node alone owns would be destroyed recursively; move
+   their own children out first, with an explicit stack. Only a sole owner
+   can see a use count of 1, so no other thread can take a reference to a
+   node while it is taken apart here. */
+template <typename T>
+PersistentBST<T>::Node::~Node() {
+    std::vector<Link> stack;
+    if (left.use_count() == 1)
+        stack.push_back(std::move(left));
+    if (right.use_count() == 1)
+        stack.push_back(std::move(right));
+
+    while (!stack.empty()) {
+        Link t = std::move(stack.back());
+        stack.pop_back();
+
+        if (t->left.use_count() == 1)
+            stack.push_back(std::move(t->left));
+        if (t->right.use_count() == 1)
+            stack.push_back(std::move(t->right));
+    }
+}
+
+template <typename T>
+typename PersistentBST<T>::Link PersistentBST<T>::copy_path(const Path& path, Link sub) {
+    for (size_t i = path.size(); i-- > 0;) {
+        const Node* p = path[i].first;
+        if (path[i].second)
+            sub = std::make_shared<const Node>(p->element, std::move(sub), p->right);
+        else
+            sub = std::make_shared<const Node>(p->element, p->left, std::move(sub));
+    }
+    return sub;
+}
+
+template <typename T>
+PersistentBST<T> PersistentBST<T>::insert(const T& key) const {
+    Path path;
+    const Node* t = root.get();
+
+    while (t) {
+        if (t->element == key)
+            return *this;
+
+        bool left = t->element > key;
+        path.emplace_back(t, left);
+        t = left ? t->left.get() : t->right.get();
+    }
+
+    Link node = std::make_shared<const Node>(key, nullptr, nullptr);
+    return PersistentBST(copy_path(path, std::move(node)), size_ + 1);
+}
+
+template <typename T>
+PersistentBST<T> PersistentBST<T>::remove(const T& key) const {
+    Path path;
+    const Node* x = root.get();
+
+    while (x && x->element != key) {
+        bool left = x->element > key;
+        path.emplace_back(x, left);
+        x = left ? x->left.get() : x->right.get();
+    }
+
+    // not in tree
+    if (!x)
+        return *this;
+
+    Link replacement;
+
+    // 1. is a leaf, or 2. has one child: the child (if any) takes its place
+    if (!x->left)
+        replacement = x->right;
+    else if (!x->right)
+        replacement = x->left;
+
+    // 3. has two children: copy the path down to the maximum of the left
+    // subtree, and let the copy of x carry the maximum's key
+    else {
+        Path to_max;
+        const Node* max = x->left.get();
+        while (max->right) {
+            to_max.emplace_back(max, false);
+            max = max->right.get();
+        }
+
+        Link left = copy_path(to_max, max->left);
+        replacement = std::make_shared<const Node>(max->element, std::move(left), x->right);
+    }
+
+    return PersistentBST(copy_path(path, std::move(replacement)), size_ - 1);
+}
+
+template <typename T>
+bool PersistentBST<T>::search(const T& key) const {
+    const Node* t = root.get();
+
+    while (t && t->element != key)
+        t = t->element > key ? t->left.get() : t->right.get();
+
+    return t != nullptr;
+}
+
+template <typename T>
+std::vector<T> PersistentBST<T>::to_sorted_vector() const {
+    std::vector<T> keys;
+    keys.reserve(size_);
+    std::vector<const Node*> stack;
+    const Node* t = root.get();
+
+    while (t || !stack.empty()) {
+        while (t) {
+            stack.push_back(t);
+            t = t->left.get();
+        }
+        t = stack.back();
+        stack.pop_back();
+        keys.push_back(t->element);
+        t = t->right.get();
+    }
+    return keys;
+}
+
+#endif // _PERSISTENT_BST_H
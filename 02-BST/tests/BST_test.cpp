@@ -1,9 +1,16 @@
 #include <algorithm>
+#include <atomic>
 #include <iterator>
+#include <numeric>
 #include <vector>
 #include <random>
+#include <set>
+#include <thread>
 
 #include "BST.hpp"
+#include "arena_bst.hpp"
+#include "concurrent_bst.hpp"
+#include "persistent_bst.hpp"
 
 #define CATCH_CONFIG_MAIN
 #include <catch2/catch.hpp>
@@ -105,3 +112,466 @@ TEST_CASE("BST remove test", "[BST]") {
 
 
 }
+
+
+TEST_CASE("BST degenerate tree", "[BST]") {
+
+    // A right spine of sorted keys, linked directly so that building it is O(n)
+    const int n = 500000;
+    BST<int> bt;
+    std::unique_ptr<TreeNode<int>>* link = &bt.root;
+    for (int i = 0; i < n; i++) {
+        *link = std::make_unique<TreeNode<int>>(2 * i);
+        (*link)->size = n - i;
+        link = &(*link)->right;
+    }
+    REQUIRE(bt.size() == n);
+
+    REQUIRE(bt.search(2 * (n - 1)) == true);
+    REQUIRE(bt.search(2 * n - 1) == false);
+    REQUIRE(bt.insert(2 * n - 1) == true);
+    REQUIRE(bt.remove(2 * (n - 1)) == true);
+    REQUIRE(bt.remove(2 * (n - 1)) == false);
+    REQUIRE(bt.size() == n);
+    REQUIRE(bt.rank(2 * n - 1) == n - 1);
+    REQUIRE(*bt.select(n - 1) == 2 * n - 1);
+
+    int count = 0;
+    int prev = -1;
+    for (int key : bt) {
+        REQUIRE(key > prev);
+        prev = key;
+        count++;
+    }
+    REQUIRE(count == n);
+    REQUIRE(prev == 2 * n - 1);
+
+}
+
+
+TEST_CASE("BST reverse sorted scan", "[BST]") {
+
+    // The left spine that reverse sorted insertion builds: every ++ climbs
+    // back to a parent, which must not cost a walk from the root
+    const int n = 500000;
+    BST<int> bt;
+    std::unique_ptr<TreeNode<int>>* link = &bt.root;
+    for (int i = n - 1; i >= 0; i--) {
+        *link = std::make_unique<TreeNode<int>>(i);
+        (*link)->size = i + 1;
+        link = &(*link)->left;
+    }
+    REQUIRE(bt.size() == n);
+
+    int expected = 0;
+    for (int key : bt)
+        REQUIRE(key == expected++);
+    REQUIRE(expected == n);
+
+    expected = n / 2;
+    for (auto it = bt.lower_bound(n / 2); it != bt.end(); ++it)
+        REQUIRE(*it == expected++);
+    REQUIRE(expected == n);
+
+    REQUIRE(*bt.upper_bound(n - 2) == n - 1);
+    REQUIRE(bt.upper_bound(n - 1) == bt.end());
+    REQUIRE(*std::next(bt.select(n / 3)) == n / 3 + 1);
+
+}
+
+
+TEST_CASE("BST cursor test", "[BST]") {
+
+    BST<int> bt;
+    REQUIRE(bt.begin() == bt.end());
+    REQUIRE(bt.lower_bound(0) == bt.end());
+
+    std::vector<int> v;
+    v.resize(10000);
+    std::generate(v.begin(), v.end(), std::rand);
+    std::sort(v.begin(), v.end());
+    auto last = std::unique(v.begin(), v.end());
+    v.erase(last, v.end());
+
+    std::vector<int> shuffled = v;
+    std::random_shuffle(shuffled.begin(), shuffled.end());
+    for (auto ele: shuffled)
+        bt.insert(ele);
+
+    REQUIRE(std::equal(bt.begin(), bt.end(), v.begin(), v.end()));
+
+    std::mt19937 gen(16);
+    for (int i = 0; i < 1000; i++) {
+        int lo = gen() % (RAND_MAX - RAND_MAX / 100);
+        int hi = lo + gen() % (RAND_MAX / 100);
+
+        // Range scan [lo, hi)
+        std::vector<int> scanned;
+        for (auto it = bt.lower_bound(lo); it != bt.end() && *it < hi; ++it)
+            scanned.push_back(*it);
+
+        std::vector<int> expected(std::lower_bound(v.begin(), v.end(), lo),
+                                  std::lower_bound(v.begin(), v.end(), hi));
+        REQUIRE(scanned == expected);
+
+        auto ub = bt.upper_bound(lo);
+        auto it = std::upper_bound(v.begin(), v.end(), lo);
+        if (it == v.end())
+            REQUIRE(ub == bt.end());
+        else
+            REQUIRE(*ub == *it);
+    }
+
+    // Upper bound of an existing key
+    REQUIRE(*bt.upper_bound(v[0]) == v[1]);
+    REQUIRE(*bt.lower_bound(v[0]) == v[0]);
+
+}
+
+
+template <typename T>
+size_t height(const std::unique_ptr<TreeNode<T>>& t) {
+    return t ? 1 + std::max(height(t->left), height(t->right)) : 0;
+}
+
+TEMPLATE_TEST_CASE("Balanced BST test", "[BST]", ScapegoatBalance, TreapBalance) {
+
+    BST<int, TestType> bt;
+
+    // Sorted insertion, then reverse sorted removal of half of the keys
+    const int n = 100000;
+    for (int i = 0; i < n; i++) {
+        REQUIRE(bt.insert(2 * i) == true);
+        REQUIRE(bt.insert(2 * i) == false);
+    }
+    REQUIRE(height(bt.root) < 50);
+
+    for (int i = n - 1; i >= n / 2; i--) {
+        REQUIRE(bt.remove(2 * i) == true);
+        REQUIRE(bt.remove(2 * i) == false);
+    }
+    REQUIRE(height(bt.root) < 50);
+
+    for (int i = 0; i < n; i++) {
+        REQUIRE(bt.search(2 * i) == (i < n / 2));
+        REQUIRE(bt.search(2 * i + 1) == false);
+    }
+
+    std::vector<int> sorted;
+    is_BST(bt.root, sorted);
+    REQUIRE(sorted.size() == n / 2);
+    REQUIRE(std::equal(bt.begin(), bt.end(), sorted.begin(), sorted.end()));
+
+    // Random insertions and removals
+    std::mt19937 gen(17);
+    for (int i = 0; i < 100000; i++) {
+        int key = gen() % 20000;
+        if (gen() % 2)
+            bt.insert(key);
+        else
+            bt.remove(key);
+    }
+
+    sorted.clear();
+    is_BST(bt.root, sorted);
+    REQUIRE(std::is_sorted(sorted.begin(), sorted.end()));
+    REQUIRE(height(bt.root) < 50);
+
+}
+
+
+TEST_CASE("Arena BST test", "[BST]") {
+
+    ArenaBST<int> bt;
+    std::set<int> ref;
+
+    std::mt19937 gen(18);
+    for (int round = 0; round < 2; round++) {
+        for (int i = 0; i < 200000; i++) {
+            int key = gen() % 50000;
+            if (gen() % 3)
+                REQUIRE(bt.insert(key) == ref.insert(key).second);
+            else
+                REQUIRE(bt.remove(key) == (ref.erase(key) == 1));
+        }
+
+        REQUIRE(bt.size() == ref.size());
+        REQUIRE(std::equal(bt.begin(), bt.end(), ref.begin(), ref.end()));
+        for (int key = 0; key < 50000; key += 7)
+            REQUIRE(bt.search(key) == (ref.count(key) == 1));
+
+        int lo = gen() % 50000;
+        REQUIRE(*bt.lower_bound(lo) == *ref.lower_bound(lo));
+
+        bt.clear();
+        ref.clear();
+        REQUIRE(bt.empty());
+        REQUIRE(bt.begin() == bt.end());
+    }
+
+    // A million nodes, freed by the arena in one go
+    bt.reserve(1000000);
+    std::vector<int> keys(1000000);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::shuffle(keys.begin(), keys.end(), gen);
+    for (int key : keys)
+        bt.insert(key);
+    REQUIRE(bt.size() == 1000000);
+    REQUIRE(*bt.begin() == 0);
+
+}
+
+
+TEST_CASE("Arena BST degenerate scan", "[BST]") {
+
+    // Sorted and reverse sorted inserts give a right and a left spine; on
+    // the left one every ++ climbs back to a parent
+    const int n = 10000;
+    for (bool descending : {false, true}) {
+        ArenaBST<int> bt;
+        for (int i = 0; i < n; i++)
+            REQUIRE(bt.insert(descending ? n - 1 - i : i) == true);
+        REQUIRE(bt.size() == n);
+
+        int expected = 0;
+        for (int key : bt)
+            REQUIRE(key == expected++);
+        REQUIRE(expected == n);
+
+        expected = n / 2;
+        for (auto it = bt.lower_bound(n / 2); it != bt.end(); ++it)
+            REQUIRE(*it == expected++);
+        REQUIRE(expected == n);
+
+        REQUIRE(*bt.upper_bound(n - 2) == n - 1);
+        REQUIRE(bt.upper_bound(n - 1) == bt.end());
+    }
+
+}
+
+
+TEMPLATE_TEST_CASE("BST bulk load and merge test", "[BST]", Unbalanced, ScapegoatBalance, TreapBalance) {
+
+    std::vector<int> v(100000);
+    std::iota(v.begin(), v.end(), 0);
+    for (auto& x : v)
+        x *= 3;
+
+    auto bt = BST<int, TestType>::build_from_sorted(v.begin(), v.end());
+    REQUIRE(bt.to_sorted_vector() == v);
+    REQUIRE(height(bt.root) < 50);
+    if (!std::is_same_v<TestType, TreapBalance>)
+        REQUIRE(height(bt.root) == 17);
+
+    REQUIRE(bt.search(300) == true);
+    REQUIRE(bt.insert(301) == true);
+    REQUIRE(bt.remove(300) == true);
+    REQUIRE(bt.remove(300) == false);
+
+    // Duplicates in the input are kept once
+    std::vector<int> dup{1, 1, 2, 3, 3, 3};
+    auto small = BST<int, TestType>::build_from_sorted(dup.begin(), dup.end());
+    REQUIRE(small.to_sorted_vector() == std::vector<int>{1, 2, 3});
+
+    // Merge with an overlapping tree
+    std::vector<int> w;
+    for (int i = 0; i < 50000; i++)
+        w.push_back(2 * i);
+    auto other = BST<int, TestType>::build_from_sorted(w.begin(), w.end());
+
+    bt.merge(other);
+    REQUIRE(other.root == nullptr);
+    REQUIRE(other.to_sorted_vector().empty());
+
+    std::set<int> expected(v.begin(), v.end());
+    expected.insert(301);
+    expected.erase(300);
+    expected.insert(w.begin(), w.end());
+    std::vector<int> sorted;
+    is_BST(bt.root, sorted);
+    REQUIRE(std::equal(sorted.begin(), sorted.end(), expected.begin(), expected.end()));
+    REQUIRE(height(bt.root) < 50);
+
+    // Both trees keep working after the merge
+    REQUIRE(bt.insert(1000001) == true);
+    REQUIRE(other.insert(5) == true);
+    REQUIRE(other.search(5) == true);
+
+}
+
+
+template <typename T>
+size_t check_sizes(const std::unique_ptr<TreeNode<T>>& t) {
+    if (!t)
+        return 0;
+    size_t size = 1 + check_sizes(t->left) + check_sizes(t->right);
+    REQUIRE(t->size == size);
+    return size;
+}
+
+TEMPLATE_TEST_CASE("BST order statistics test", "[BST]", Unbalanced, ScapegoatBalance, TreapBalance) {
+
+    BST<int, TestType> bt;
+    std::set<int> ref;
+
+    std::mt19937 gen(20);
+    for (int i = 0; i < 30000; i++) {
+        int key = gen() % 10000;
+        if (gen() % 3)
+            REQUIRE(bt.insert(key) == ref.insert(key).second);
+        else
+            REQUIRE(bt.remove(key) == (ref.erase(key) == 1));
+    }
+    check_sizes(bt.root);
+    REQUIRE(bt.size() == ref.size());
+
+    std::vector<int> sorted(ref.begin(), ref.end());
+    for (size_t k = 0; k < sorted.size(); k++)
+        REQUIRE(*bt.select(k) == sorted[k]);
+    REQUIRE(bt.select(sorted.size()) == bt.end());
+
+    for (int key = -1; key <= 10001; key += 13) {
+        size_t rank = std::lower_bound(sorted.begin(), sorted.end(), key) - sorted.begin();
+        REQUIRE(bt.rank(key) == rank);
+    }
+
+    for (int i = 0; i < 1000; i++) {
+        int lo = gen() % 10000;
+        int hi = gen() % 10000;
+        size_t expected = lo < hi ? std::distance(ref.lower_bound(lo), ref.lower_bound(hi)) : 0;
+        REQUIRE(bt.count_range(lo, hi) == expected);
+    }
+
+    // Sizes survive bulk loads and merges
+    auto other = BST<int, TestType>::build_from_sorted(sorted.begin(), sorted.end());
+    check_sizes(other.root);
+    std::vector<int> odds{1, 3, 5, 7, 10001};
+    auto more = BST<int, TestType>::build_from_sorted(odds.begin(), odds.end());
+    other.merge(more);
+    check_sizes(other.root);
+    ref.insert(odds.begin(), odds.end());
+    REQUIRE(other.size() == ref.size());
+    REQUIRE(*other.select(other.size() - 1) == 10001);
+
+}
+
+
+TEST_CASE("Concurrent BST single thread test", "[BST]") {
+
+    ConcurrentBST<int> bt;
+    std::set<int> ref;
+
+    std::mt19937 gen(21);
+    for (int i = 0; i < 100000; i++) {
+        int key = gen() % 5000;
+        if (gen() % 2)
+            REQUIRE(bt.insert(key) == ref.insert(key).second);
+        else
+            REQUIRE(bt.remove(key) == (ref.erase(key) == 1));
+    }
+    bt.synchronize();
+
+    for (int key = 0; key < 5000; key++)
+        REQUIRE(bt.search(key) == (ref.count(key) == 1));
+
+}
+
+
+TEST_CASE("Concurrent BST readers and writer test", "[BST]") {
+
+    // Even keys stay in the tree for good; odd keys come and go around them,
+    // so removals keep rewriting paths that readers are walking
+    ConcurrentBST<int> bt;
+    std::vector<int> keys(20000);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(21));
+    for (int key : keys)
+        bt.insert(key);
+
+    std::atomic<bool> done{false};
+    std::atomic<size_t> missing{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; r++) {
+        readers.emplace_back([&, r] {
+            std::mt19937 gen(r);
+            while (!done.load(std::memory_order_relaxed))
+                if (!bt.search(2 * (gen() % 10000)))
+                    missing++;
+        });
+    }
+
+    std::mt19937 gen(22);
+    for (int i = 0; i < 200000; i++) {
+        int key = 2 * (gen() % 10000) + 1;
+        if (gen() % 2)
+            bt.insert(key);
+        else
+            bt.remove(key);
+    }
+    done = true;
+    for (auto& t : readers)
+        t.join();
+
+    REQUIRE(missing == 0);
+    for (int key = 0; key < 20000; key += 2)
+        REQUIRE(bt.search(key));
+
+}
+
+
+TEST_CASE("Persistent BST versions test", "[BST]") {
+
+    // Keep every 100th version with the key set it should hold
+    std::vector<std::pair<PersistentBST<int>, std::set<int>>> history;
+    PersistentBST<int> bt;
+    std::set<int> ref;
+
+    std::mt19937 gen(22);
+    for (int i = 0; i < 20000; i++) {
+        int key = gen() % 3000;
+        if (gen() % 3) {
+            bt = bt.insert(key);
+            ref.insert(key);
+        } else {
+            bt = bt.remove(key);
+            ref.erase(key);
+        }
+        REQUIRE(bt.size() == ref.size());
+
+        if (i % 100 == 0)
+            history.emplace_back(bt, ref);
+    }
+
+    // Old versions are untouched by everything that came after them
+    for (auto& [version, keys] : history) {
+        std::vector<int> expected(keys.begin(), keys.end());
+        REQUIRE(version.to_sorted_vector() == expected);
+        REQUIRE(version.size() == keys.size());
+        for (int key = 0; key < 3000; key += 37)
+            REQUIRE(version.search(key) == (keys.count(key) == 1));
+    }
+
+    // No-op updates give back the same version
+    REQUIRE(bt.remove(-1).same_version(bt));
+    if (!ref.empty())
+        REQUIRE(bt.insert(*ref.begin()).same_version(bt));
+
+}
+
+
+TEST_CASE("Persistent BST deep version test", "[BST]") {
+
+    PersistentBST<int> bt;
+    for (int i = 0; i < 5000; i++)
+        bt = bt.insert(i);
+
+    PersistentBST<int> snapshot = bt;
+    for (int i = 0; i < 5000; i += 2)
+        bt = bt.remove(i);
+
+    REQUIRE(bt.size() == 2500);
+    REQUIRE(snapshot.size() == 5000);
+    REQUIRE(snapshot.search(0));
+    REQUIRE(!bt.search(0));
+
+}
@@ -0,0 +1,25 @@
+#ifndef _BENCH_TIMER_H
+#define _BENCH_TIMER_H
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+
+/* Wall-clock nanoseconds per operation of f(), which runs `ops` of them */
+template <typename F>
+double ns_per_op(F f, size_t ops) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / ops;
+}
+
+/* The timed loops add what they find to a checksum, so that the compiler
+ * cannot drop them; a zero checksum means they found nothing. */
+template <typename T>
+void check_sum(T sum) {
+    if (sum == 0)
+        std::cerr << "unexpected result\n";
+}
+
+#endif // _BENCH_TIMER_H
@@ -0,0 +1,85 @@
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "btree_map.hpp"
+#include "bench_timer.hpp"
+
+/* Insert n random 64-bit keys with 64-bit values into a BTreeMap and a
+ * std::map, then look up every key in a different random order, look up
+ * n keys that are not there, visit 100 entries from n / 100 random
+ * lower_bounds, and erase every key. Prints the time per operation.
+ * Usage: btree_map_bench [n] (10'000'000 by default) */
+
+using Key = uint64_t;
+using Value = uint64_t;
+constexpr size_t B = 16;
+
+void print(const char* name, double insert, double hit, double miss, double range, double erase) {
+    std::cout << std::left << std::setw(16) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << insert << std::setw(10) << hit << std::setw(10) << miss
+              << std::setw(10) << range << std::setw(10) << erase << '\n';
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = argc > 1 ? std::stoul(argv[1]) : 10'000'000;
+    std::mt19937_64 g(42);
+
+    /* Even keys are inserted, odd ones are misses */
+    std::vector<Key> keys(n), lookups(n), misses(n), starts(std::max<size_t>(1, n / 100));
+    for (auto& k : keys)
+        k = g() & ~Key{1};
+    lookups = keys;
+    std::shuffle(lookups.begin(), lookups.end(), g);
+    for (auto& k : misses)
+        k = g() | 1;
+    for (auto& k : starts)
+        k = g();
+
+    std::cout << "ns per op, n = " << n << '\n';
+    std::cout << std::left << std::setw(16) << "" << std::right << std::setw(10) << "insert"
+              << std::setw(10) << "find" << std::setw(10) << "miss" << std::setw(10) << "range"
+              << std::setw(10) << "erase" << '\n';
+
+    Value sum = 0;
+    size_t range_ops = starts.size() * 100;
+
+    {
+        BTreeMap<Key, Value, B> map;
+        double insert = ns_per_op([&] { for (Key k : keys) map.insert_or_assign(k, k); }, n);
+        double hit = ns_per_op([&] { for (Key k : lookups) sum += *map.find(k); }, n);
+        double miss = ns_per_op([&] { for (Key k : misses) sum += map.find(k) != nullptr; }, n);
+        double range = ns_per_op([&] {
+            for (Key k : starts) {
+                auto it = map.lower_bound(k);
+                for (int i = 0; i < 100 && it != map.end(); i++, ++it)
+                    sum += it.value();
+            }
+        }, range_ops);
+        double erase = ns_per_op([&] { for (Key k : lookups) map.erase(k); }, n);
+        print("BTreeMap", insert, hit, miss, range, erase);
+    }
+
+    {
+        std::map<Key, Value> map;
+        double insert = ns_per_op([&] { for (Key k : keys) map.insert_or_assign(k, k); }, n);
+        double hit = ns_per_op([&] { for (Key k : lookups) sum += map.find(k)->second; }, n);
+        double miss = ns_per_op([&] { for (Key k : misses) sum += map.find(k) != map.end(); }, n);
+        double range = ns_per_op([&] {
+            for (Key k : starts) {
+                auto it = map.lower_bound(k);
+                for (int i = 0; i < 100 && it != map.end(); i++, ++it)
+                    sum += it->second;
+            }
+        }, range_ops);
+        double erase = ns_per_op([&] { for (Key k : lookups) map.erase(k); }, n);
+        print("std::map", insert, hit, miss, range, erase);
+    }
+
+    check_sum(sum);
+}
@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "btree.hpp"
+#include "bench_timer.hpp"
+
+/* For each order B from 2 to 128, time the in-node search kernels on full
+ * nodes (2B - 1 keys) and a lookup in a B-tree of n keys with get_index's
+ * choice of kernel. Nodes are spread over a few MiB so that the keys are
+ * not always in L1, as in a real tree. The kernels are timed on 32-bit ints;
+ * "simd" is the linear scan unless built with AVX2 (-DBTREE_AVX2=ON).
+ * Usage: node_search_bench [n] */
+
+using Key = int32_t;
+
+template <size_t B, typename Kernel>
+double time_kernel(Kernel kernel, const std::vector<Key>& nodes, const std::vector<Key>& queries) {
+    constexpr size_t width = 2 * B - 1;
+    size_t count = nodes.size() / width;
+    size_t sum = 0;
+
+    double ns = ns_per_op([&] {
+        for (size_t q = 0; q < queries.size(); q++)
+            sum += kernel(nodes.data() + (q % count) * width, width, queries[q]);
+    }, queries.size());
+
+    check_sum(sum);
+    return ns;
+}
+
+template <size_t B>
+void run(size_t n, std::mt19937& g) {
+    constexpr size_t width = 2 * B - 1;
+    size_t count = std::max<size_t>(1, (4 << 20) / sizeof(Key) / width);
+
+    /* Full nodes of even keys, and odd queries in their range */
+    std::vector<Key> nodes;
+    for (size_t c = 0; c < count; c++)
+        for (size_t i = 0; i < width; i++)
+            nodes.push_back(static_cast<Key>(2 * i));
+
+    std::vector<Key> queries(1 << 22);
+    for (auto& q : queries)
+        q = static_cast<Key>(g() % (2 * width + 1));
+
+    /* Lambdas rather than function pointers, so the kernels are inlined */
+    double linear = time_kernel<B>([](auto... a) { return node_search::linear_upper_bound<Key>(a...); },
+                                   nodes, queries);
+    double binary = time_kernel<B>([](auto... a) { return node_search::binary_upper_bound<Key>(a...); },
+                                   nodes, queries);
+    double simd = time_kernel<B>([](auto... a) { return node_search::simd_upper_bound<Key>(a...); },
+                                 nodes, queries);
+
+    std::vector<Key> keys(n);
+    for (size_t i = 0; i < n; i++)
+        keys[i] = static_cast<Key>(i);
+    std::shuffle(keys.begin(), keys.end(), g);
+
+    BTree<Key, B> tree;
+    for (Key k : keys)
+        tree.insert(k);
+
+    size_t found = 0;
+    double lookup = ns_per_op([&] {
+        for (Key k : keys)
+            found += BTreeNode<Key, B>::search(tree.root, k).first != nullptr;
+    }, n);
+
+    if (found != n)
+        std::cerr << "unexpected result\n";
+
+    const char* pick = node_search::use_binary_search<Key, B>() ? "binary"
+                     : node_search::has_simd_kernel<Key>::value ? "simd" : "linear";
+
+    std::cout << std::setw(5) << B << std::setw(6) << width << std::fixed << std::setprecision(2)
+              << std::setw(10) << linear << std::setw(10) << binary << std::setw(10) << simd
+              << std::setw(12) << lookup << std::setw(10) << pick << '\n';
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = argc > 1 ? std::stoul(argv[1]) : 1'000'000;
+    std::mt19937 g(42);
+
+    std::cout << "ns per search, n = " << n
+              << (node_search::has_simd_kernel<Key>::value ? " (AVX2)" : " (no AVX2)") << '\n';
+    std::cout << std::setw(5) << "B" << std::setw(6) << "keys" << std::setw(10) << "linear"
+              << std::setw(10) << "binary" << std::setw(10) << "simd" << std::setw(12) << "tree"
+              << std::setw(10) << "picks" << '\n';
+
+    run<2>(n, g);
+    run<3>(n, g);
+    run<4>(n, g);
+    run<6>(n, g);
+    run<8>(n, g);
+    run<12>(n, g);
+    run<16>(n, g);
+    run<24>(n, g);
+    run<32>(n, g);
+    run<48>(n, g);
+    run<64>(n, g);
+    run<96>(n, g);
+    run<128>(n, g);
+}
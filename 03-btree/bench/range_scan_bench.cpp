@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "bplustree.hpp"
+#include "btree.hpp"
+#include "bench_timer.hpp"
+
+/* Build a BTree, a BPlusTree and a std::set of n random keys, then time
+ * a full in-order walk of each, and range scans of 10 to 100'000 keys
+ * starting at random keys (BPlusTree::scan against lower_bound and
+ * iteration on std::set; BTree has no range query). Times are per key
+ * visited.
+ * Usage: range_scan_bench [n] */
+
+using Key = int64_t;
+constexpr size_t B = 16;
+
+int main(int argc, char* argv[]) {
+    size_t n = argc > 1 ? std::stoul(argv[1]) : 1'000'000;
+    std::mt19937_64 g(42);
+
+    std::vector<Key> keys(n);
+    for (size_t i = 0; i < n; i++)
+        keys[i] = static_cast<Key>(i);
+    std::shuffle(keys.begin(), keys.end(), g);
+
+    BTree<Key, B> btree;
+    BPlusTree<Key, B> bplus;
+    std::set<Key> set;
+    for (Key k : keys) {
+        btree.insert(k);
+        bplus.insert(k);
+        set.insert(k);
+    }
+
+    Key sum = 0;
+    std::cout << std::fixed << std::setprecision(2) << "ns per key, n = " << n << ", B = " << B << '\n';
+
+    double walk_btree = ns_per_op([&] { btree.for_all([&sum](Key& k) { sum += k; }); }, n);
+    double walk_bplus = ns_per_op([&] { bplus.for_all([&sum](Key k) { sum += k; }); }, n);
+    double walk_set = ns_per_op([&] { for (Key k : set) sum += k; }, n);
+
+    std::cout << std::setw(10) << "range" << std::setw(12) << "BTree" << std::setw(12) << "BPlusTree"
+              << std::setw(12) << "std::set" << '\n';
+    std::cout << std::setw(10) << "all" << std::setw(12) << walk_btree << std::setw(12) << walk_bplus
+              << std::setw(12) << walk_set << '\n';
+
+    for (size_t length : {10, 1'000, 100'000}) {
+        if (length > n)
+            break;
+
+        size_t scans = std::max<size_t>(1, 10'000'000 / length);
+        std::vector<Key> starts(scans);
+        for (auto& s : starts)
+            s = static_cast<Key>(g() % (n - length + 1));
+
+        size_t visited = scans * length;
+        double scan_bplus = ns_per_op([&] {
+            for (Key lo : starts)
+                bplus.scan(lo, lo + static_cast<Key>(length), [&sum](Key k) { sum += k; });
+        }, visited);
+        double scan_set = ns_per_op([&] {
+            for (Key lo : starts)
+                for (auto it = set.lower_bound(lo); it != set.end() && *it < lo + static_cast<Key>(length); ++it)
+                    sum += *it;
+        }, visited);
+
+        std::cout << std::setw(10) << length << std::setw(12) << "-" << std::setw(12) << scan_bplus
+                  << std::setw(12) << scan_set << '\n';
+    }
+
+    check_sum(sum);
+}
@@ -0,0 +1,459 @@
+#ifndef _BPLUSTREE_H
+#define _BPLUSTREE_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "btree.hpp"
+#include "node_search.hpp"
+
+/* A B+tree: every key lives in a leaf, and the leaves are chained in key
+ * order by their `next` pointers.
+ *
+ * Internal nodes only route. Their keys are separators: everything in
+ * edges[i] is < keys[i], everything in edges[i + 1] is >= keys[i]. A
+ * separator is a copy of a key and may stay behind after the key is
+ * removed. Nodes hold between B - 1 and 2B - 1 keys (the root, fewer), and
+ * are split on the way down when inserting and filled on the way down when
+ * removing, as in BTree, so neither goes back up the tree.
+ *
+ * A range scan finds its first leaf once and then only follows `next`:
+ * it reads the keys of each leaf in one go and never climbs back to an
+ * internal node, unlike BTree::for_all.
+ */
+template<typename T, size_t B = 6>
+struct BPlusTreeNode {
+    NodeType type;
+    size_t n;
+    std::array<T, 2 * B - 1> keys;
+    std::array<BPlusTreeNode*, 2 * B> edges;
+
+    /* The next leaf in key order, nullptr for the last one (leaves only) */
+    BPlusTreeNode* next;
+
+    BPlusTreeNode() : type(NodeType::LEAF), n(0), next(nullptr) {}
+    ~BPlusTreeNode();
+
+    /* The edge to descend into for t */
+    size_t get_index(const T& t) const {
+        return node_search::node_upper_bound<B>(keys.data(), n, t);
+    }
+
+    /* Assume parent.edges[idx] is full and parent is not */
+    static void split_child(BPlusTreeNode&, size_t);
+    /* Assume parent.edges[idx] has B - 1 keys. Returns the edge now
+       covering what edges[idx] covered. */
+    static size_t fill_child(BPlusTreeNode&, size_t);
+    static void borrow_from_left(BPlusTreeNode&, size_t);
+    static void borrow_from_right(BPlusTreeNode&, size_t);
+    static void merge_children(BPlusTreeNode&, size_t);
+};
+
+template<typename T, size_t B = 6>
+struct BPlusTree {
+    using Node = BPlusTreeNode<T, B>;
+
+    Node* root = nullptr;
+
+    BPlusTree() = default;
+    ~BPlusTree() { if (root) delete root; }
+
+    BPlusTree(const BPlusTree&) = delete;
+    BPlusTree& operator=(const BPlusTree&) = delete;
+
+    /* false if t is already in the tree */
+    bool insert(const T&);
+    /* false if t is not in the tree */
+    bool remove(const T&);
+    bool contains(const T&) const;
+
+    class const_iterator;
+    using iterator = const_iterator;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+    /* The first key >= t */
+    const_iterator lower_bound(const T&) const;
+
+    /* Call f on every key in [lo, hi), in order */
+    template<typename F>
+    void scan(const T& lo, const T& hi, F&& f) const;
+
+    /* Call f on every key, in order */
+    template<typename F>
+    void for_all(F&& f) const;
+
+    template<typename F>
+    void for_all_nodes(F&& f) const;
+
+    const std::optional<size_t> depth() const;
+
+private:
+    /* The leaf holding the first key >= t, and its position there */
+    std::pair<const Node*, size_t> find_lower_bound(const T&) const;
+};
+
+template<typename T, size_t B>
+class BPlusTree<T, B>::const_iterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T*;
+    using reference = const T&;
+
+    const_iterator() = default;
+
+    reference operator*() const { return leaf->keys[i]; }
+    pointer operator->() const { return &leaf->keys[i]; }
+
+    const_iterator& operator++() {
+        if (++i == leaf->n) {
+            leaf = leaf->next;
+            i = 0;
+        }
+        return *this;
+    }
+
+    const_iterator operator++(int) {
+        const_iterator old = *this;
+        ++*this;
+        return old;
+    }
+
+    bool operator==(const const_iterator& other) const { return leaf == other.leaf && i == other.i; }
+    bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+private:
+    friend struct BPlusTree<T, B>;
+
+    const_iterator(const Node* leaf, size_t i) : leaf(leaf), i(i) {}
+
+    const Node* leaf = nullptr;
+    size_t i = 0;
+};
+
+template<typename T, size_t B>
+BPlusTreeNode<T, B>::~BPlusTreeNode() {
+    if (type == NodeType::LEAF)
+        return;
+
+    for (size_t i = 0; i < n + 1; i++)
+        delete edges[i];
+}
+
+/* Leaves: the full node keeps the first B keys, and the new right sibling
+   the other B - 1, the first of which is copied up as the separator. The
+   full node stays where it is, so the `next` link into it stays valid.
+   Internal nodes: the middle key moves up, as in BTree. */
+template<typename T, size_t B>
+void BPlusTreeNode<T, B>::split_child(BPlusTreeNode& parent, size_t idx) {
+    BPlusTreeNode* child = parent.edges[idx];
+    BPlusTreeNode* sibling = new BPlusTreeNode{};
+    sibling->type = child->type;
+    T separator;
+
+    if (child->type == NodeType::LEAF) {
+        std::copy(child->keys.begin() + B, child->keys.begin() + 2 * B - 1, sibling->keys.begin());
+        sibling->n = B - 1;
+        child->n = B;
+        separator = sibling->keys[0];
+
+        sibling->next = child->next;
+        child->next = sibling;
+    } else {
+        std::copy(child->keys.begin() + B, child->keys.begin() + 2 * B - 1, sibling->keys.begin());
+        std::copy(child->edges.begin() + B, child->edges.begin() + 2 * B, sibling->edges.begin());
+        sibling->n = B - 1;
+        child->n = B - 1;
+        separator = child->keys[B - 1];
+    }
+
+    std::move_backward(parent.keys.begin() + idx, parent.keys.begin() + parent.n,
+                       parent.keys.begin() + parent.n + 1);
+    std::move_backward(parent.edges.begin() + idx + 1, parent.edges.begin() + parent.n + 1,
+                       parent.edges.begin() + parent.n + 2);
+    parent.keys[idx] = separator;
+    parent.edges[idx + 1] = sibling;
+    parent.n++;
+}
+
+template<typename T, size_t B>
+size_t BPlusTreeNode<T, B>::fill_child(BPlusTreeNode& parent, size_t idx) {
+    if (idx > 0 && parent.edges[idx - 1]->n >= B) {
+        borrow_from_left(parent, idx);
+        return idx;
+    }
+
+    if (idx < parent.n && parent.edges[idx + 1]->n >= B) {
+        borrow_from_right(parent, idx);
+        return idx;
+    }
+
+    if (idx < parent.n) {
+        merge_children(parent, idx);
+        return idx;
+    }
+
+    merge_children(parent, idx - 1);
+    return idx - 1;
+}
+
+/* Leaves move the key itself, and the separator becomes the child's new
+   first key. Internal nodes rotate through the separator, as in BTree. */
+template<typename T, size_t B>
+void BPlusTreeNode<T, B>::borrow_from_left(BPlusTreeNode& parent, size_t idx) {
+    BPlusTreeNode* child = parent.edges[idx];
+    BPlusTreeNode* sibling = parent.edges[idx - 1];
+
+    std::move_backward(child->keys.begin(), child->keys.begin() + child->n,
+                       child->keys.begin() + child->n + 1);
+
+    if (child->type == NodeType::LEAF) {
+        child->keys[0] = sibling->keys[sibling->n - 1];
+        parent.keys[idx - 1] = child->keys[0];
+    } else {
+        std::move_backward(child->edges.begin(), child->edges.begin() + child->n + 1,
+                           child->edges.begin() + child->n + 2);
+        child->keys[0] = parent.keys[idx - 1];
+        child->edges[0] = sibling->edges[sibling->n];
+        parent.keys[idx - 1] = sibling->keys[sibling->n - 1];
+    }
+
+    child->n++;
+    sibling->n--;
+}
+
+template<typename T, size_t B>
+void BPlusTreeNode<T, B>::borrow_from_right(BPlusTreeNode& parent, size_t idx) {
+    BPlusTreeNode* child = parent.edges[idx];
+    BPlusTreeNode* sibling = parent.edges[idx + 1];
+
+    if (child->type == NodeType::LEAF) {
+        child->keys[child->n] = sibling->keys[0];
+        parent.keys[idx] = sibling->keys[1];
+    } else {
+        child->keys[child->n] = parent.keys[idx];
+        child->edges[child->n + 1] = sibling->edges[0];
+        parent.keys[idx] = sibling->keys[0];
+        std::move(sibling->edges.begin() + 1, sibling->edges.begin() + sibling->n + 1,
+                  sibling->edges.begin());
+    }
+    std::move(sibling->keys.begin() + 1, sibling->keys.begin() + sibling->n, sibling->keys.begin());
+
+    child->n++;
+    sibling->n--;
+}
+
+/* Merge parent.edges[idx + 1] into parent.edges[idx]. Leaves drop the
+   separator and unlink the right one from the chain; internal nodes pull
+   the separator down between the two halves, as in BTree. */
+template<typename T, size_t B>
+void BPlusTreeNode<T, B>::merge_children(BPlusTreeNode& parent, size_t idx) {
+    BPlusTreeNode* child = parent.edges[idx];
+    BPlusTreeNode* sibling = parent.edges[idx + 1];
+
+    if (child->type == NodeType::LEAF) {
+        child->next = sibling->next;
+    } else {
+        child->keys[child->n] = parent.keys[idx];
+        child->n++;
+        std::copy(sibling->edges.begin(), sibling->edges.begin() + sibling->n + 1,
+                  child->edges.begin() + child->n);
+    }
+    std::copy(sibling->keys.begin(), sibling->keys.begin() + sibling->n,
+              child->keys.begin() + child->n);
+    child->n += sibling->n;
+
+    std::move(parent.keys.begin() + idx + 1, parent.keys.begin() + parent.n,
+              parent.keys.begin() + idx);
+    std::move(parent.edges.begin() + idx + 2, parent.edges.begin() + parent.n + 1,
+              parent.edges.begin() + idx + 1);
+    parent.n--;
+
+    /* Its edges now belong to child */
+    sibling->type = NodeType::LEAF;
+    delete sibling;
+}
+
+template<typename T, size_t B>
+bool BPlusTree<T, B>::insert(const T& t) {
+    if (!root)
+        root = new Node{};
+
+    if (root->n == 2 * B - 1) {
+        Node* new_root = new Node{};
+        new_root->type = NodeType::INTERNAL;
+        new_root->edges[0] = root;
+        Node::split_child(*new_root, 0);
+        root = new_root;
+    }
+
+    Node* node = root;
+    while (node->type == NodeType::INTERNAL) {
+        size_t i = node->get_index(t);
+        if (node->edges[i]->n == 2 * B - 1) {
+            Node::split_child(*node, i);
+            if (!(t < node->keys[i]))
+                i++;
+        }
+        node = node->edges[i];
+    }
+
+    size_t i = node_search::node_lower_bound<B>(node->keys.data(), node->n, t);
+    if (i < node->n && node->keys[i] == t)
+        return false;
+
+    std::move_backward(node->keys.begin() + i, node->keys.begin() + node->n,
+                       node->keys.begin() + node->n + 1);
+    node->keys[i] = t;
+    node->n++;
+    return true;
+}
+
+template<typename T, size_t B>
+bool BPlusTree<T, B>::remove(const T& t) {
+    if (!root)
+        return false;
+
+    Node* node = root;
+    while (node->type == NodeType::INTERNAL) {
+        size_t i = node->get_index(t);
+        if (node->edges[i]->n < B)
+            i = Node::fill_child(*node, i);
+        node = node->edges[i];
+    }
+
+    size_t i = node_search::node_lower_bound<B>(node->keys.data(), node->n, t);
+    bool found = i < node->n && node->keys[i] == t;
+    if (found) {
+        std::move(node->keys.begin() + i + 1, node->keys.begin() + node->n, node->keys.begin() + i);
+        node->n--;
+    }
+
+    /* Merging the only two children of the root empties it; this is the
+       only way the tree gets shallower. */
+    if (root->type == NodeType::INTERNAL && root->n == 0) {
+        Node* prev_root = root;
+        root = root->edges[0];
+        prev_root->type = NodeType::LEAF;
+        delete prev_root;
+    } else if (root->type == NodeType::LEAF && root->n == 0) {
+        delete root;
+        root = nullptr;
+    }
+
+    return found;
+}
+
+template<typename T, size_t B>
+bool BPlusTree<T, B>::contains(const T& t) const {
+    auto [leaf, i] = find_lower_bound(t);
+    return leaf && leaf->keys[i] == t;
+}
+
+/* A separator equal to t sends the search right, where t would be */
+template<typename T, size_t B>
+std::pair<const BPlusTreeNode<T, B>*, size_t> BPlusTree<T, B>::find_lower_bound(const T& t) const {
+    if (!root)
+        return { nullptr, 0 };
+
+    const Node* node = root;
+    while (node->type == NodeType::INTERNAL)
+        node = node->edges[node->get_index(t)];
+
+    size_t i = node_search::node_lower_bound<B>(node->keys.data(), node->n, t);
+    if (i == node->n)
+        return { node->next, 0 };
+    return { node, i };
+}
+
+template<typename T, size_t B>
+typename BPlusTree<T, B>::const_iterator BPlusTree<T, B>::begin() const {
+    if (!root)
+        return end();
+
+    const Node* node = root;
+    while (node->type == NodeType::INTERNAL)
+        node = node->edges[0];
+    return const_iterator(node, 0);
+}
+
+template<typename T, size_t B>
+typename BPlusTree<T, B>::const_iterator BPlusTree<T, B>::end() const {
+    return const_iterator(nullptr, 0);
+}
+
+template<typename T, size_t B>
+typename BPlusTree<T, B>::const_iterator BPlusTree<T, B>::lower_bound(const T& t) const {
+    auto [leaf, i] = find_lower_bound(t);
+    return const_iterator(leaf, i);
+}
+
+/* Only the leaf where the range ends is searched for hi; the leaves before
+   it are handed to f whole. */
+template<typename T, size_t B>
+template<typename F>
+void BPlusTree<T, B>::scan(const T& lo, const T& hi, F&& f) const {
+    if (!(lo < hi))
+        return;
+
+    auto [leaf, i] = find_lower_bound(lo);
+    for (; leaf; leaf = leaf->next, i = 0) {
+        size_t last = leaf->n;
+        bool ends_here = !(leaf->keys[last - 1] < hi);
+        if (ends_here)
+            last = node_search::node_lower_bound<B>(leaf->keys.data(), last, hi);
+
+        for (; i < last; i++)
+            f(leaf->keys[i]);
+
+        if (ends_here)
+            return;
+    }
+}
+
+template<typename T, size_t B>
+template<typename F>
+void BPlusTree<T, B>::for_all(F&& f) const {
+    for (const Node* leaf = begin().leaf; leaf; leaf = leaf->next)
+        for (size_t i = 0; i < leaf->n; i++)
+            f(leaf->keys[i]);
+}
+
+/* Level by level, from the root down */
+template<typename T, size_t B>
+template<typename F>
+void BPlusTree<T, B>::for_all_nodes(F&& f) const {
+    if (!root)
+        return;
+
+    std::vector<const Node*> level{root}, below;
+    while (!level.empty()) {
+        for (const Node* node : level) {
+            f(*node);
+            if (node->type == NodeType::INTERNAL)
+                below.insert(below.end(), node->edges.begin(), node->edges.begin() + node->n + 1);
+        }
+        level.swap(below);
+        below.clear();
+    }
+}
+
+template<typename T, size_t B>
+const std::optional<size_t> BPlusTree<T, B>::depth() const {
+    if (!root)
+        return std::nullopt;
+
+    size_t d = 0;
+    for (const Node* node = root; node->type == NodeType::INTERNAL; node = node->edges[0])
+        d++;
+    return d;
+}
+
+#endif // _BPLUSTREE_H
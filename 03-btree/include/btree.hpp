@@ -1,3 +1,6 @@
+#ifndef _BTREE_H
+#define _BTREE_H
+
 #include <cstddef>
 #include <array>
 #include <iostream>
@@ -9,6 +12,8 @@
 #include <sstream>
 #include <functional>
 
+#include "node_search.hpp"
+
 enum class NodeType { LEAF, INTERNAL };
 
 template<typename T, size_t B = 6>
@@ -168,16 +173,13 @@ bool BTreeNode<T, B>::insert(const T& t) {
  *     n.get_index(10) = 2
  *     n.get_index(19) = 3
  *     n.get_index(31) = 4
+ *
+ * The kernel (linear, SIMD or binary search) is picked from B and T; see
+ * node_search.hpp.
  */
 template<typename T, size_t B>
 size_t BTreeNode<T, B>::get_index(const T& t) {
-    // TODO
-    size_t temp = 0;
-    for(temp = 0; temp < n; temp++){
-        if(t < keys[temp])
-            break;
-    }
-    return temp;
+    return node_search::node_upper_bound<B>(keys.data(), n, t);
 }
 
 template<typename T, size_t B>
@@ -295,10 +297,7 @@ template<typename T, size_t B>
 bool BTreeNode<T, B>::remove(const T& t) {
     // TODO
     // find index
-    size_t idx = 0;
-    while (idx < n && keys[idx] < t){
-        idx++;
-    }
+    size_t idx = node_search::node_lower_bound<B>(keys.data(), n, t);
 
     // found node
     if(idx < n && keys[idx] == t){
@@ -509,25 +508,17 @@ T& BTreeNode<T, B>::find_rightmost_key(BTreeNode<T, B>& node) {
 template<typename T, size_t B>
 std::pair<BTreeNode<T, B>*, size_t>
 BTreeNode<T, B>::search(BTreeNode<T, B>* node, const T& t) {
-    if (node->type == NodeType::LEAF) {
-        for (auto i = 0; i < node->keys.size(); i++)
-            if (t == node->keys[i])
-                return { node, i };
+    while (true) {
+        size_t i = node_search::node_lower_bound<B>(node->keys.data(), node->n, t);
 
-        return { nullptr, -1 };
-    }
-
-    size_t i;
-    for (i = 0; i < node->n; i++) {
-        if (t == node->keys[i])
+        if (i < node->n && t == node->keys[i])
             return { node, i };
 
-        if (t < node->keys[i]) {
-            return search(node->edges[i], t);
-        }
-    }
+        if (node->type == NodeType::LEAF)
+            return { nullptr, -1 };
 
-    return search(node->edges[i], t);
+        node = node->edges[i];
+    }
 }
 
 template<typename T, size_t B>
@@ -631,4 +622,6 @@ BTreeNode<T, B>::~BTreeNode() {
     for (auto i = 0; i < n + 1; i++){
         if (edges[i]) delete edges[i];
     }
-}
\ No newline at end of file
+}
+
+#endif // _BTREE_H
@@ -0,0 +1,463 @@
+#ifndef _BTREE_MAP_H
+#define _BTREE_MAP_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <utility>
+
+#include "btree.hpp"
+#include "node_search.hpp"
+
+/* A B-tree map from K to V.
+ *
+ * A node keeps its keys and its values in two parallel arrays, keys first,
+ * so a search only reads the keys (and edges) of the nodes it visits: the
+ * values, which may be much larger, stay out of the cache lines it brings
+ * in until the key is found. Both K and V must be default constructible.
+ *
+ * Insertion splits full nodes on the way down, and erase fills nodes with
+ * B - 1 keys on the way down (the deletion of CLRS ch. 18), so neither ever
+ * walks back up.
+ */
+template<typename K, typename V, size_t B = 6>
+struct BTreeMapNode {
+    NodeType type;
+    size_t n;
+    std::array<K, 2 * B - 1> keys;
+    std::array<BTreeMapNode*, 2 * B> edges;
+    std::array<V, 2 * B - 1> values;
+
+    BTreeMapNode() : type(NodeType::LEAF), n(0) {}
+    ~BTreeMapNode();
+
+    /* The number of keys < k */
+    size_t get_index(const K& k) const {
+        return node_search::node_lower_bound<B>(keys.data(), n, k);
+    }
+
+    /* Assume node.edges[idx] is full and node is not */
+    static void split_child(BTreeMapNode&, size_t);
+    /* Assume node.edges[idx] has B - 1 keys. Returns the edge now covering
+       what edges[idx] covered. */
+    static size_t fill_child(BTreeMapNode&, size_t);
+    static void borrow_from_left(BTreeMapNode&, size_t);
+    static void borrow_from_right(BTreeMapNode&, size_t);
+    static void merge_children(BTreeMapNode&, size_t);
+};
+
+template<typename K, typename V, size_t B = 6>
+struct BTreeMap {
+    using Node = BTreeMapNode<K, V, B>;
+
+    Node* root = nullptr;
+
+    BTreeMap() = default;
+    ~BTreeMap() { if (root) delete root; }
+
+    BTreeMap(const BTreeMap&) = delete;
+    BTreeMap& operator=(const BTreeMap&) = delete;
+
+    /* The value of k, or nullptr if k is not in the map */
+    V* find(const K& k);
+    const V* find(const K& k) const;
+
+    /* true if k was inserted, false if its value was replaced */
+    bool insert_or_assign(const K& k, V v);
+    /* false if k is not in the map */
+    bool erase(const K& k);
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    class iterator;
+
+    iterator begin();
+    iterator end();
+    /* The first key >= k */
+    iterator lower_bound(const K& k);
+
+private:
+    size_t size_ = 0;
+};
+
+/* In-order cursor. It keeps the path from the root, so it needs no parent
+   links; the path of a B-tree is short, and max_depth levels are enough for
+   any tree that fits in memory. Inserting or erasing invalidates it. */
+template<typename K, typename V, size_t B>
+class BTreeMap<K, V, B>::iterator {
+public:
+    static constexpr size_t max_depth = 64;
+
+    iterator() = default;
+
+    const K& key() const { return top().first->keys[top().second]; }
+    V& value() const { return top().first->values[top().second]; }
+
+    iterator& operator++();
+
+    iterator operator++(int) {
+        iterator old = *this;
+        ++*this;
+        return old;
+    }
+
+    bool operator==(const iterator& other) const {
+        return depth == other.depth && (depth == 0 || top() == other.top());
+    }
+    bool operator!=(const iterator& other) const { return !(*this == other); }
+
+private:
+    friend struct BTreeMap<K, V, B>;
+
+    /* A node on the path and, for the last one, the current key; for the
+       others, the edge the path goes down (the next key after it) */
+    std::array<std::pair<Node*, size_t>, max_depth> path;
+    size_t depth = 0;
+
+    const std::pair<Node*, size_t>& top() const { return path[depth - 1]; }
+    std::pair<Node*, size_t>& top() { return path[depth - 1]; }
+
+    void push(Node* node, size_t i) { path[depth++] = { node, i }; }
+    void descend_leftmost(Node* node);
+    /* Pop the nodes whose keys have all been visited */
+    void pop_finished();
+};
+
+template<typename K, typename V, size_t B>
+void BTreeMap<K, V, B>::iterator::descend_leftmost(Node* node) {
+    push(node, 0);
+    while (node->type == NodeType::INTERNAL) {
+        node = node->edges[0];
+        push(node, 0);
+    }
+}
+
+template<typename K, typename V, size_t B>
+void BTreeMap<K, V, B>::iterator::pop_finished() {
+    while (depth > 0 && top().second == top().first->n)
+        depth--;
+}
+
+template<typename K, typename V, size_t B>
+typename BTreeMap<K, V, B>::iterator& BTreeMap<K, V, B>::iterator::operator++() {
+    auto& [node, i] = top();
+    i++;
+
+    if (node->type == NodeType::INTERNAL)
+        descend_leftmost(node->edges[i]);
+    else
+        pop_finished();
+    return *this;
+}
+
+template<typename K, typename V, size_t B>
+BTreeMapNode<K, V, B>::~BTreeMapNode() {
+    if (type == NodeType::LEAF)
+        return;
+
+    for (size_t i = 0; i < n + 1; i++)
+        delete edges[i];
+}
+
+/* The middle key and its value move up into node */
+template<typename K, typename V, size_t B>
+void BTreeMapNode<K, V, B>::split_child(BTreeMapNode& node, size_t idx) {
+    BTreeMapNode* child = node.edges[idx];
+    BTreeMapNode* sibling = new BTreeMapNode{};
+    sibling->type = child->type;
+
+    std::move(child->keys.begin() + B, child->keys.begin() + 2 * B - 1, sibling->keys.begin());
+    std::move(child->values.begin() + B, child->values.begin() + 2 * B - 1, sibling->values.begin());
+    if (child->type == NodeType::INTERNAL)
+        std::copy(child->edges.begin() + B, child->edges.begin() + 2 * B, sibling->edges.begin());
+    sibling->n = B - 1;
+    child->n = B - 1;
+
+    std::move_backward(node.keys.begin() + idx, node.keys.begin() + node.n,
+                       node.keys.begin() + node.n + 1);
+    std::move_backward(node.values.begin() + idx, node.values.begin() + node.n,
+                       node.values.begin() + node.n + 1);
+    std::move_backward(node.edges.begin() + idx + 1, node.edges.begin() + node.n + 1,
+                       node.edges.begin() + node.n + 2);
+    node.keys[idx] = std::move(child->keys[B - 1]);
+    node.values[idx] = std::move(child->values[B - 1]);
+    node.edges[idx + 1] = sibling;
+    node.n++;
+}
+
+template<typename K, typename V, size_t B>
+size_t BTreeMapNode<K, V, B>::fill_child(BTreeMapNode& node, size_t idx) {
+    if (idx > 0 && node.edges[idx - 1]->n >= B) {
+        borrow_from_left(node, idx);
+        return idx;
+    }
+
+    if (idx < node.n && node.edges[idx + 1]->n >= B) {
+        borrow_from_right(node, idx);
+        return idx;
+    }
+
+    if (idx < node.n) {
+        merge_children(node, idx);
+        return idx;
+    }
+
+    merge_children(node, idx - 1);
+    return idx - 1;
+}
+
+/* Rotate right through node.keys[idx - 1] */
+template<typename K, typename V, size_t B>
+void BTreeMapNode<K, V, B>::borrow_from_left(BTreeMapNode& node, size_t idx) {
+    BTreeMapNode* child = node.edges[idx];
+    BTreeMapNode* sibling = node.edges[idx - 1];
+
+    std::move_backward(child->keys.begin(), child->keys.begin() + child->n,
+                       child->keys.begin() + child->n + 1);
+    std::move_backward(child->values.begin(), child->values.begin() + child->n,
+                       child->values.begin() + child->n + 1);
+    if (child->type == NodeType::INTERNAL) {
+        std::move_backward(child->edges.begin(), child->edges.begin() + child->n + 1,
+                           child->edges.begin() + child->n + 2);
+        child->edges[0] = sibling->edges[sibling->n];
+    }
+
+    child->keys[0] = std::move(node.keys[idx - 1]);
+    child->values[0] = std::move(node.values[idx - 1]);
+    node.keys[idx - 1] = std::move(sibling->keys[sibling->n - 1]);
+    node.values[idx - 1] = std::move(sibling->values[sibling->n - 1]);
+
+    child->n++;
+    sibling->n--;
+}
+
+/* Rotate left through node.keys[idx] */
+template<typename K, typename V, size_t B>
+void BTreeMapNode<K, V, B>::borrow_from_right(BTreeMapNode& node, size_t idx) {
+    BTreeMapNode* child = node.edges[idx];
+    BTreeMapNode* sibling = node.edges[idx + 1];
+
+    child->keys[child->n] = std::move(node.keys[idx]);
+    child->values[child->n] = std::move(node.values[idx]);
+    node.keys[idx] = std::move(sibling->keys[0]);
+    node.values[idx] = std::move(sibling->values[0]);
+
+    if (child->type == NodeType::INTERNAL) {
+        child->edges[child->n + 1] = sibling->edges[0];
+        std::move(sibling->edges.begin() + 1, sibling->edges.begin() + sibling->n + 1,
+                  sibling->edges.begin());
+    }
+    std::move(sibling->keys.begin() + 1, sibling->keys.begin() + sibling->n, sibling->keys.begin());
+    std::move(sibling->values.begin() + 1, sibling->values.begin() + sibling->n,
+              sibling->values.begin());
+
+    child->n++;
+    sibling->n--;
+}
+
+/* Pull node.keys[idx] down between edges[idx] and edges[idx + 1], and merge
+   the two into edges[idx] */
+template<typename K, typename V, size_t B>
+void BTreeMapNode<K, V, B>::merge_children(BTreeMapNode& node, size_t idx) {
+    BTreeMapNode* child = node.edges[idx];
+    BTreeMapNode* sibling = node.edges[idx + 1];
+
+    child->keys[child->n] = std::move(node.keys[idx]);
+    child->values[child->n] = std::move(node.values[idx]);
+    child->n++;
+
+    std::move(sibling->keys.begin(), sibling->keys.begin() + sibling->n, child->keys.begin() + child->n);
+    std::move(sibling->values.begin(), sibling->values.begin() + sibling->n,
+              child->values.begin() + child->n);
+    if (child->type == NodeType::INTERNAL)
+        std::copy(sibling->edges.begin(), sibling->edges.begin() + sibling->n + 1,
+                  child->edges.begin() + child->n);
+    child->n += sibling->n;
+
+    std::move(node.keys.begin() + idx + 1, node.keys.begin() + node.n, node.keys.begin() + idx);
+    std::move(node.values.begin() + idx + 1, node.values.begin() + node.n, node.values.begin() + idx);
+    std::move(node.edges.begin() + idx + 2, node.edges.begin() + node.n + 1,
+              node.edges.begin() + idx + 1);
+    node.n--;
+
+    /* Its edges now belong to child */
+    sibling->type = NodeType::LEAF;
+    delete sibling;
+}
+
+template<typename K, typename V, size_t B>
+V* BTreeMap<K, V, B>::find(const K& k) {
+    Node* node = root;
+
+    while (node) {
+        size_t i = node->get_index(k);
+        if (i < node->n && node->keys[i] == k)
+            return &node->values[i];
+        node = node->type == NodeType::LEAF ? nullptr : node->edges[i];
+    }
+    return nullptr;
+}
+
+template<typename K, typename V, size_t B>
+const V* BTreeMap<K, V, B>::find(const K& k) const {
+    return const_cast<BTreeMap*>(this)->find(k);
+}
+
+template<typename K, typename V, size_t B>
+bool BTreeMap<K, V, B>::insert_or_assign(const K& k, V v) {
+    if (!root)
+        root = new Node{};
+
+    if (root->n == 2 * B - 1) {
+        Node* new_root = new Node{};
+        new_root->type = NodeType::INTERNAL;
+        new_root->edges[0] = root;
+        Node::split_child(*new_root, 0);
+        root = new_root;
+    }
+
+    Node* node = root;
+    while (true) {
+        size_t i = node->get_index(k);
+        if (i < node->n && node->keys[i] == k) {
+            node->values[i] = std::move(v);
+            return false;
+        }
+
+        if (node->type == NodeType::LEAF) {
+            std::move_backward(node->keys.begin() + i, node->keys.begin() + node->n,
+                               node->keys.begin() + node->n + 1);
+            std::move_backward(node->values.begin() + i, node->values.begin() + node->n,
+                               node->values.begin() + node->n + 1);
+            node->keys[i] = k;
+            node->values[i] = std::move(v);
+            node->n++;
+            size_++;
+            return true;
+        }
+
+        /* The key that moves up may be k itself, or smaller than it */
+        if (node->edges[i]->n == 2 * B - 1) {
+            Node::split_child(*node, i);
+            if (node->keys[i] == k) {
+                node->values[i] = std::move(v);
+                return false;
+            }
+            if (node->keys[i] < k)
+                i++;
+        }
+        node = node->edges[i];
+    }
+}
+
+/* On the way down, every node entered has at least B keys, so a key can be
+   taken out of it without refilling it from above */
+template<typename K, typename V, size_t B>
+bool BTreeMap<K, V, B>::erase(const K& k) {
+    if (!root)
+        return false;
+
+    Node* node = root;
+    K target = k;
+    bool found = false;
+
+    while (true) {
+        size_t i = node->get_index(target);
+
+        if (i < node->n && node->keys[i] == target) {
+            // 1. in a leaf: take it out
+            if (node->type == NodeType::LEAF) {
+                std::move(node->keys.begin() + i + 1, node->keys.begin() + node->n,
+                          node->keys.begin() + i);
+                std::move(node->values.begin() + i + 1, node->values.begin() + node->n,
+                          node->values.begin() + i);
+                node->n--;
+                found = true;
+                break;
+            }
+
+            // 2a. the left child can spare a key: replace with the
+            // predecessor, and go on to erase the predecessor
+            if (node->edges[i]->n >= B) {
+                Node* pred = node->edges[i];
+                while (pred->type == NodeType::INTERNAL)
+                    pred = pred->edges[pred->n];
+                node->keys[i] = pred->keys[pred->n - 1];
+                node->values[i] = std::move(pred->values[pred->n - 1]);
+                target = node->keys[i];
+                node = node->edges[i];
+            }
+            // 2b. or the right child can: the same with the successor
+            else if (node->edges[i + 1]->n >= B) {
+                Node* succ = node->edges[i + 1];
+                while (succ->type == NodeType::INTERNAL)
+                    succ = succ->edges[0];
+                node->keys[i] = succ->keys[0];
+                node->values[i] = std::move(succ->values[0]);
+                target = node->keys[i];
+                node = node->edges[i + 1];
+            }
+            // 2c. neither can: merge them around the key, and go on there
+            else {
+                Node::merge_children(*node, i);
+                node = node->edges[i];
+            }
+            continue;
+        }
+
+        // 3. not here: make sure the child to go down has a key to spare
+        if (node->type == NodeType::LEAF)
+            break;
+        if (node->edges[i]->n < B)
+            i = Node::fill_child(*node, i);
+        node = node->edges[i];
+    }
+
+    /* After merging, the size of the root may become 0. */
+    if (root->type == NodeType::INTERNAL && root->n == 0) {
+        Node* prev_root = root;
+        root = root->edges[0];
+        prev_root->type = NodeType::LEAF;
+        delete prev_root;
+    } else if (root->type == NodeType::LEAF && root->n == 0) {
+        delete root;
+        root = nullptr;
+    }
+
+    if (found)
+        size_--;
+    return found;
+}
+
+template<typename K, typename V, size_t B>
+typename BTreeMap<K, V, B>::iterator BTreeMap<K, V, B>::begin() {
+    iterator it;
+    if (root && root->n > 0)
+        it.descend_leftmost(root);
+    return it;
+}
+
+template<typename K, typename V, size_t B>
+typename BTreeMap<K, V, B>::iterator BTreeMap<K, V, B>::end() {
+    return iterator{};
+}
+
+template<typename K, typename V, size_t B>
+typename BTreeMap<K, V, B>::iterator BTreeMap<K, V, B>::lower_bound(const K& k) {
+    iterator it;
+    Node* node = root;
+
+    while (node) {
+        size_t i = node->get_index(k);
+        it.push(node, i);
+        if (i < node->n && node->keys[i] == k)
+            return it;
+        node = node->type == NodeType::LEAF ? nullptr : node->edges[i];
+    }
+
+    it.pop_finished();
+    return it;
+}
+
+#endif // _BTREE_MAP_H
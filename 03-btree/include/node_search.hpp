@@ -0,0 +1,232 @@
+#ifndef _NODE_SEARCH_H
+#define _NODE_SEARCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/* Kernels that find the position of a key among the n sorted keys of a node.
+ *
+ * Every kernel comes in two flavours: upper_bound, the number of keys <= t
+ * (the edge to descend into, as get_index wants), and lower_bound, the
+ * number of keys < t (where t is, if it is in the node).
+ *
+ * - linear: a plain scan that stops at the first key past t. Best for a
+ *   handful of keys, but the exit branch mispredicts once per search.
+ * - binary: a branchless binary search. The loop runs ceil(log2 n) times
+ *   whatever the keys are, and each step is a conditional move.
+ * - simd: compares t with 8 (or 4) keys at once and counts the matching
+ *   lanes with movemask, over the whole node and without a branch. Only
+ *   for 32 and 64-bit integers, float and double, and only when built with
+ *   AVX2; otherwise it is the linear scan.
+ *
+ * node_upper_bound/node_lower_bound pick one of them from the node order B
+ * and the key type. See bench/node_search_bench for the crossover points.
+ */
+namespace node_search {
+
+template<typename T>
+size_t linear_upper_bound(const T* keys, size_t n, const T& t) {
+    size_t i = 0;
+    while (i < n && !(t < keys[i]))
+        i++;
+    return i;
+}
+
+template<typename T>
+size_t linear_lower_bound(const T* keys, size_t n, const T& t) {
+    size_t i = 0;
+    while (i < n && keys[i] < t)
+        i++;
+    return i;
+}
+
+/* The range [base, base + len) always holds the last key that is not past
+   t, if there is one; halving it is a conditional move, not a branch. */
+template<typename T>
+size_t binary_upper_bound(const T* keys, size_t n, const T& t) {
+    if (n == 0)
+        return 0;
+
+    const T* base = keys;
+    while (n > 1) {
+        size_t half = n / 2;
+        base = (t < base[half]) ? base : base + half;
+        n -= half;
+    }
+    return (base - keys) + !(t < *base);
+}
+
+template<typename T>
+size_t binary_lower_bound(const T* keys, size_t n, const T& t) {
+    if (n == 0)
+        return 0;
+
+    const T* base = keys;
+    while (n > 1) {
+        size_t half = n / 2;
+        base = (base[half] < t) ? base + half : base;
+        n -= half;
+    }
+    return (base - keys) + (*base < t);
+}
+
+#if defined(__AVX2__)
+
+template<typename T>
+struct has_simd_kernel
+    : std::integral_constant<bool, (std::is_integral<T>::value && (sizeof(T) == 4 || sizeof(T) == 8))
+                                   || std::is_same<T, float>::value
+                                   || std::is_same<T, double>::value> {};
+
+namespace detail {
+
+/* Lanes [0, count) of a vector of 8 (or 4) keys, count < 8 (or 4): all
+   ones for the lanes to load, zero for the others */
+template<typename T>
+__m256i lane_mask(size_t count) {
+    if constexpr (sizeof(T) == 4)
+        return _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int32_t>(count)),
+                                  _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    else
+        return _mm256_cmpgt_epi64(_mm256_set1_epi64x(static_cast<int64_t>(count)),
+                                  _mm256_setr_epi64x(0, 1, 2, 3));
+}
+
+/* The lanes of 8 (or 4) keys that are < t, or <= t if `or_equal`, as a bit
+   mask of 32 bits, 4 (or 8) per lane. Only the lanes in `load` are read;
+   the others count as past t. Unsigned keys are compared as signed ones
+   with the sign bit flipped. */
+template<typename T, bool or_equal>
+uint32_t below_mask(const T* keys, const T& t, __m256i load) {
+    if constexpr (std::is_same<T, float>::value) {
+        __m256 k = _mm256_maskload_ps(keys, load);
+        __m256 v = _mm256_set1_ps(t);
+        __m256 c = or_equal ? _mm256_cmp_ps(k, v, _CMP_LE_OQ) : _mm256_cmp_ps(k, v, _CMP_LT_OQ);
+        return _mm256_movemask_epi8(_mm256_and_si256(_mm256_castps_si256(c), load));
+    } else if constexpr (std::is_same<T, double>::value) {
+        __m256d k = _mm256_maskload_pd(keys, load);
+        __m256d v = _mm256_set1_pd(t);
+        __m256d c = or_equal ? _mm256_cmp_pd(k, v, _CMP_LE_OQ) : _mm256_cmp_pd(k, v, _CMP_LT_OQ);
+        return _mm256_movemask_epi8(_mm256_and_si256(_mm256_castpd_si256(c), load));
+    } else {
+        __m256i k, v;
+        if constexpr (sizeof(T) == 4) {
+            k = _mm256_maskload_epi32(reinterpret_cast<const int*>(keys), load);
+            v = _mm256_set1_epi32(static_cast<int32_t>(t));
+        } else {
+            k = _mm256_maskload_epi64(reinterpret_cast<const long long*>(keys), load);
+            v = _mm256_set1_epi64x(static_cast<int64_t>(t));
+        }
+
+        if constexpr (std::is_unsigned<T>::value) {
+            __m256i sign = sizeof(T) == 4 ? _mm256_set1_epi32(INT32_MIN) : _mm256_set1_epi64x(INT64_MIN);
+            k = _mm256_xor_si256(k, sign);
+            v = _mm256_xor_si256(v, sign);
+        }
+
+        /* k < v is v > k; k <= v is not k > v */
+        __m256i c;
+        if constexpr (sizeof(T) == 4)
+            c = or_equal ? _mm256_cmpgt_epi32(k, v) : _mm256_cmpgt_epi32(v, k);
+        else
+            c = or_equal ? _mm256_cmpgt_epi64(k, v) : _mm256_cmpgt_epi64(v, k);
+        c = or_equal ? _mm256_andnot_si256(c, load) : _mm256_and_si256(c, load);
+
+        return _mm256_movemask_epi8(c);
+    }
+}
+
+/* Count the keys below t over the whole node, a vector at a time. There is
+   no early exit: with no branch on the keys, nothing mispredicts, and a
+   node of up to 64 keys is only 8 vectors. The last, partial vector is a
+   masked load, so nothing past n is read. */
+template<typename T, bool or_equal>
+size_t simd_bound(const T* keys, size_t n, const T& t) {
+    constexpr size_t lanes = 32 / sizeof(T);
+    const __m256i all = _mm256_set1_epi32(-1);
+    size_t bits = 0;
+    size_t i = 0;
+
+    for (; i + lanes <= n; i += lanes)
+        bits += __builtin_popcount(below_mask<T, or_equal>(keys + i, t, all));
+    if (i < n)
+        bits += __builtin_popcount(below_mask<T, or_equal>(keys + i, t, lane_mask<T>(n - i)));
+
+    return bits / sizeof(T);
+}
+
+} // namespace detail
+
+template<typename T>
+size_t simd_upper_bound(const T* keys, size_t n, const T& t) {
+    if constexpr (has_simd_kernel<T>::value)
+        return detail::simd_bound<T, true>(keys, n, t);
+    else
+        return linear_upper_bound(keys, n, t);
+}
+
+template<typename T>
+size_t simd_lower_bound(const T* keys, size_t n, const T& t) {
+    if constexpr (has_simd_kernel<T>::value)
+        return detail::simd_bound<T, false>(keys, n, t);
+    else
+        return linear_lower_bound(keys, n, t);
+}
+
+#else
+
+template<typename T>
+struct has_simd_kernel : std::false_type {};
+
+template<typename T>
+size_t simd_upper_bound(const T* keys, size_t n, const T& t) {
+    return linear_upper_bound(keys, n, t);
+}
+
+template<typename T>
+size_t simd_lower_bound(const T* keys, size_t n, const T& t) {
+    return linear_lower_bound(keys, n, t);
+}
+
+#endif
+
+/* Nodes with at most this many keys are scanned (with SIMD if there is a
+   kernel for the key type); larger ones are binary searched. On random
+   searches the branchless binary search beats the scalar scan from 5 keys
+   on, and the SIMD scan up to about 63 keys (B = 32). */
+constexpr size_t linear_max_keys = 3;
+constexpr size_t simd_max_keys = 63;
+
+template<typename T, size_t B>
+constexpr bool use_binary_search() {
+    return 2 * B - 1 > (has_simd_kernel<T>::value ? simd_max_keys : linear_max_keys);
+}
+
+template<size_t B, typename T>
+size_t node_upper_bound(const T* keys, size_t n, const T& t) {
+    if constexpr (use_binary_search<T, B>())
+        return binary_upper_bound(keys, n, t);
+    else if constexpr (has_simd_kernel<T>::value)
+        return simd_upper_bound(keys, n, t);
+    else
+        return linear_upper_bound(keys, n, t);
+}
+
+template<size_t B, typename T>
+size_t node_lower_bound(const T* keys, size_t n, const T& t) {
+    if constexpr (use_binary_search<T, B>())
+        return binary_lower_bound(keys, n, t);
+    else if constexpr (has_simd_kernel<T>::value)
+        return simd_lower_bound(keys, n, t);
+    else
+        return linear_lower_bound(keys, n, t);
+}
+
+} // namespace node_search
+
+#endif // _NODE_SEARCH_H
@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <iterator>
+#include <set>
+#include <vector>
+#include <random>
+
+#include "bplustree.hpp"
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+/* Every node but the root holds B-1 to 2B-1 keys, all leaves are at the
+   same depth, and the leaf chain holds the keys in order */
+template<typename T, size_t B>
+void check_invariants(const BPlusTree<T, B>& tree, const std::set<T>& expected) {
+    size_t leaf_keys = 0;
+    size_t leaves = 0;
+
+    tree.for_all_nodes([&](const BPlusTreeNode<T, B>& node) {
+        if (&node != tree.root)
+            REQUIRE((B - 1 <= node.n && node.n <= 2 * B - 1));
+        if (node.type == NodeType::LEAF) {
+            leaf_keys += node.n;
+            leaves++;
+        }
+    });
+
+    size_t chained = 0;
+    if (tree.root) {
+        const BPlusTreeNode<T, B>* leaf = tree.root;
+        while (leaf->type == NodeType::INTERNAL)
+            leaf = leaf->edges[0];
+        for (; leaf; leaf = leaf->next)
+            chained++;
+    }
+
+    /* Leaves not all at one depth would be missed by the walk by levels */
+    REQUIRE(chained == leaves);
+    REQUIRE(leaf_keys == expected.size());
+    REQUIRE(std::equal(tree.begin(), tree.end(), expected.begin(), expected.end()));
+}
+
+template<size_t B>
+void random_operations(size_t N) {
+    BPlusTree<int, B> tree;
+    std::set<int> expected;
+    std::mt19937 g(B);
+
+    for (size_t i = 0; i < N; i++) {
+        int k = static_cast<int>(g() % (N / 2));
+        if (g() % 3 == 0)
+            REQUIRE(tree.remove(k) == (expected.erase(k) == 1));
+        else
+            REQUIRE(tree.insert(k) == expected.insert(k).second);
+    }
+    check_invariants(tree, expected);
+
+    for (int k = -1; k <= static_cast<int>(N / 2); k++)
+        REQUIRE(tree.contains(k) == (expected.count(k) == 1));
+
+    /* Remove everything */
+    std::vector<int> rest(expected.begin(), expected.end());
+    std::shuffle(rest.begin(), rest.end(), g);
+    for (int k : rest)
+        REQUIRE(tree.remove(k));
+
+    REQUIRE(tree.root == nullptr);
+    REQUIRE(tree.begin() == tree.end());
+}
+
+TEST_CASE("Random inserts and removes against std::set", "[bplustree]") {
+    random_operations<2>(100'000);
+    random_operations<3>(100'000);
+    random_operations<6>(100'000);
+    random_operations<32>(100'000);
+}
+
+TEST_CASE("lower_bound and scan", "[bplustree]") {
+    BPlusTree<int, 4> tree;
+    std::set<int> expected;
+    std::mt19937 g(5);
+
+    /* Multiples of 3, then every other one removed, so that separators of
+       removed keys are left behind */
+    for (int i = 0; i < 30'000; i++) {
+        tree.insert(3 * i);
+        expected.insert(3 * i);
+    }
+    for (int i = 0; i < 30'000; i += 2) {
+        tree.remove(3 * i);
+        expected.erase(3 * i);
+    }
+
+    for (int q = 0; q < 10'000; q++) {
+        int lo = static_cast<int>(g() % 100'000) - 5'000;
+        int hi = lo + static_cast<int>(g() % 1'000);
+
+        auto it = tree.lower_bound(lo);
+        auto e = expected.lower_bound(lo);
+        if (e == expected.end())
+            REQUIRE(it == tree.end());
+        else
+            REQUIRE((it != tree.end() && *it == *e));
+
+        std::vector<int> got;
+        tree.scan(lo, hi, [&got](int k) { got.push_back(k); });
+        std::vector<int> want(e, expected.lower_bound(hi));
+        REQUIRE(got == want);
+    }
+
+    std::vector<int> all;
+    tree.scan(-1, 100'000, [&all](int k) { all.push_back(k); });
+    REQUIRE(all == std::vector<int>(expected.begin(), expected.end()));
+}
+
+TEST_CASE("Empty tree", "[bplustree]") {
+    BPlusTree<int> tree;
+    size_t calls = 0;
+
+    REQUIRE(tree.begin() == tree.end());
+    REQUIRE(tree.lower_bound(0) == tree.end());
+    REQUIRE_FALSE(tree.contains(0));
+    REQUIRE_FALSE(tree.remove(0));
+    REQUIRE_FALSE(tree.depth().has_value());
+
+    tree.scan(0, 10, [&calls](int) { calls++; });
+    REQUIRE(calls == 0);
+}
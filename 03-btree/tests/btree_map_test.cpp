@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+#include <random>
+
+#include "btree_map.hpp"
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+/* Every node but the root holds B-1 to 2B-1 keys, and an in-order walk
+   gives the entries of the std::map */
+template<typename K, typename V, size_t B>
+void check(BTreeMap<K, V, B>& map, const std::map<K, V>& expected) {
+    REQUIRE(map.size() == expected.size());
+
+    std::vector<const BTreeMapNode<K, V, B>*> stack;
+    if (map.root)
+        stack.push_back(map.root);
+    while (!stack.empty()) {
+        auto node = stack.back();
+        stack.pop_back();
+        if (node != map.root)
+            REQUIRE((B - 1 <= node->n && node->n <= 2 * B - 1));
+        if (node->type == NodeType::INTERNAL)
+            stack.insert(stack.end(), node->edges.begin(), node->edges.begin() + node->n + 1);
+    }
+
+    auto e = expected.begin();
+    for (auto it = map.begin(); it != map.end(); ++it, ++e) {
+        REQUIRE(e != expected.end());
+        REQUIRE(it.key() == e->first);
+        REQUIRE(it.value() == e->second);
+    }
+    REQUIRE(e == expected.end());
+}
+
+template<size_t B>
+void random_operations(size_t N) {
+    BTreeMap<int, std::string, B> map;
+    std::map<int, std::string> expected;
+    std::mt19937 g(B);
+
+    for (size_t i = 0; i < N; i++) {
+        int k = static_cast<int>(g() % (N / 2));
+        if (g() % 3 == 0) {
+            REQUIRE(map.erase(k) == (expected.erase(k) == 1));
+        } else {
+            std::string v = std::to_string(g());
+            REQUIRE(map.insert_or_assign(k, v) == expected.insert_or_assign(k, v).second);
+        }
+    }
+    check(map, expected);
+
+    for (int k = -1; k <= static_cast<int>(N / 2); k++) {
+        auto e = expected.find(k);
+        std::string* v = map.find(k);
+        if (e == expected.end())
+            REQUIRE(v == nullptr);
+        else
+            REQUIRE((v && *v == e->second));
+    }
+
+    /* Erase everything */
+    std::vector<int> rest;
+    for (auto& [k, v] : expected)
+        rest.push_back(k);
+    std::shuffle(rest.begin(), rest.end(), g);
+    for (int k : rest)
+        REQUIRE(map.erase(k));
+
+    REQUIRE(map.empty());
+    REQUIRE(map.root == nullptr);
+    REQUIRE(map.begin() == map.end());
+}
+
+TEST_CASE("Random insert_or_assign and erase against std::map", "[btree_map]") {
+    random_operations<2>(100'000);
+    random_operations<3>(100'000);
+    random_operations<6>(100'000);
+    random_operations<32>(100'000);
+}
+
+TEST_CASE("lower_bound", "[btree_map]") {
+    BTreeMap<int, int, 3> map;
+    std::map<int, int> expected;
+    std::mt19937 g(5);
+
+    for (int i = 0; i < 20'000; i++) {
+        int k = static_cast<int>(g() % 100'000);
+        map.insert_or_assign(k, i);
+        expected.insert_or_assign(k, i);
+    }
+
+    for (int q = -10; q < 100'010; q += 7) {
+        auto it = map.lower_bound(q);
+        auto e = expected.lower_bound(q);
+
+        /* A few steps from there agree too */
+        for (int step = 0; step < 3 && e != expected.end(); step++, ++it, ++e) {
+            REQUIRE(it != map.end());
+            REQUIRE(it.key() == e->first);
+            REQUIRE(it.value() == e->second);
+        }
+        if (e == expected.end())
+            REQUIRE(it == map.end());
+    }
+
+    /* Values can be updated through the iterator */
+    auto it = map.lower_bound(50'000);
+    it.value() = -1;
+    REQUIRE(*map.find(it.key()) == -1);
+}
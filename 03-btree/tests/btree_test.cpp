@@ -2,6 +2,8 @@
 #include <iterator>
 #include <vector>
 #include <random>
+#include <string>
+#include <type_traits>
 
 #include "btree.hpp"
 
@@ -152,3 +154,64 @@ TEST_CASE("Perfect balance") {
                             return n->type == NodeType::LEAF;
                         }));
 }
+
+TEMPLATE_TEST_CASE("In-node search kernels agree with std::upper_bound", "[btree]",
+                   int, uint32_t, int64_t, uint64_t, float, double, std::string) {
+    std::mt19937 g(7);
+
+    /* Few distinct values, so that runs of equal keys are common */
+    auto key = [&g]() {
+        int v = static_cast<int>(g() % 64) - 32;
+        if constexpr (std::is_same<TestType, std::string>::value)
+            return std::to_string(v);
+        else
+            return static_cast<TestType>(v);
+    };
+
+#if defined(__AVX2__)
+    /* btree_avx2_test: every arithmetic key type takes the vector kernel */
+    REQUIRE(node_search::has_simd_kernel<TestType>::value == std::is_arithmetic<TestType>::value);
+#endif
+
+    for (size_t n = 0; n <= 40; n++) {
+        std::vector<TestType> keys;
+        for (size_t i = 0; i < n; i++)
+            keys.push_back(key());
+        std::sort(keys.begin(), keys.end());
+
+        for (int q = 0; q < 50; q++) {
+            TestType t = key();
+            size_t upper = std::upper_bound(keys.begin(), keys.end(), t) - keys.begin();
+            size_t lower = std::lower_bound(keys.begin(), keys.end(), t) - keys.begin();
+
+            REQUIRE(node_search::linear_upper_bound(keys.data(), n, t) == upper);
+            REQUIRE(node_search::binary_upper_bound(keys.data(), n, t) == upper);
+            REQUIRE(node_search::simd_upper_bound(keys.data(), n, t) == upper);
+            REQUIRE(node_search::linear_lower_bound(keys.data(), n, t) == lower);
+            REQUIRE(node_search::binary_lower_bound(keys.data(), n, t) == lower);
+            REQUIRE(node_search::simd_lower_bound(keys.data(), n, t) == lower);
+        }
+    }
+}
+
+TEST_CASE("Search with large B", "[btree]") {
+    BTree<int, 64> tree;
+    std::mt19937 g(11);
+    std::vector<int> xs;
+
+    for (auto i = 0; i < 100'000; i++)
+        xs.push_back(2 * i);
+    std::shuffle(xs.begin(), xs.end(), g);
+
+    for (auto i : xs)
+        tree.insert(i);
+
+    /* Even keys are there, odd ones are not */
+    for (auto i = 0; i < 200'000; i++) {
+        auto [node, idx] = BTreeNode<int, 64>::search(tree.root, i);
+        if (i % 2 == 0)
+            REQUIRE((node && node->keys[idx] == i));
+        else
+            REQUIRE(node == nullptr);
+    }
+}